@@ -60,7 +60,7 @@ void logHexNumbers()
 #endif
 }
 
-void CBattleAI::initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB)
+void CBattleAI::initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB)
 {
 	env = ENV;
 	cb = CB;
@@ -74,7 +74,7 @@ void CBattleAI::initBattleInterface(std::shared_ptr<Environment> ENV, std::share
 	logHexNumbers();
 }
 
-void CBattleAI::initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB, AutocombatPreferences autocombatPreferences)
+void CBattleAI::initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB, AutocombatPreferences autocombatPreferences)
 {
 	initBattleInterface(ENV, CB);
 	autobattlePreferences = autocombatPreferences;
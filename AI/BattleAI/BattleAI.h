@@ -55,7 +55,7 @@ struct CurrentOffensivePotential
 class CBattleAI : public CBattleGameInterface
 {
 	BattleSide side;
-	std::shared_ptr<CBattleCallback> cb;
+	std::shared_ptr<IBattleCallback> cb;
 	std::shared_ptr<Environment> env;
 
 	//Previous setting of cb
@@ -68,8 +68,8 @@ public:
 	CBattleAI();
 	~CBattleAI();
 
-	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB) override;
-	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB, AutocombatPreferences autocombatPreferences) override;
+	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB) override;
+	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB, AutocombatPreferences autocombatPreferences) override;
 
 	void activeStack(const BattleID & battleID, const CStack * stack) override; //called when it's turn of that stack
 	void yourTacticPhase(const BattleID & battleID, int distance) override;
@@ -52,7 +52,7 @@ SpellTypes spellType(const CSpell * spell)
 
 BattleEvaluator::BattleEvaluator(
 	std::shared_ptr<Environment> env,
-	std::shared_ptr<CBattleCallback> cb,
+	std::shared_ptr<IBattleCallback> cb,
 	const battle::Unit * activeStack,
 	PlayerColor playerID,
 	BattleID battleID,
@@ -71,7 +71,7 @@ BattleEvaluator::BattleEvaluator(
 
 BattleEvaluator::BattleEvaluator(
 	std::shared_ptr<Environment> env,
-	std::shared_ptr<CBattleCallback> cb,
+	std::shared_ptr<IBattleCallback> cb,
 	std::shared_ptr<HypotheticBattle> hb,
 	DamageCache & damageCache,
 	const battle::Unit * activeStack,
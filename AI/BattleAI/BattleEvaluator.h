@@ -35,7 +35,7 @@ class BattleEvaluator
 	std::unique_ptr<PotentialTargets> targets;
 	std::shared_ptr<HypotheticBattle> hb;
 	BattleExchangeEvaluator scoreEvaluator;
-	std::shared_ptr<CBattleCallback> cb;
+	std::shared_ptr<IBattleCallback> cb;
 	std::shared_ptr<Environment> env;
 	bool activeActionMade = false;
 	CachedAttack cachedAttack;
@@ -59,7 +59,7 @@ public:
 
 	BattleEvaluator(
 		std::shared_ptr<Environment> env,
-		std::shared_ptr<CBattleCallback> cb,
+		std::shared_ptr<IBattleCallback> cb,
 		const battle::Unit * activeStack,
 		PlayerColor playerID,
 		BattleID battleID,
@@ -69,7 +69,7 @@ public:
 
 	BattleEvaluator(
 		std::shared_ptr<Environment> env,
-		std::shared_ptr<CBattleCallback> cb,
+		std::shared_ptr<IBattleCallback> cb,
 		std::shared_ptr<HypotheticBattle> hb,
 		DamageCache & damageCache,
 		const battle::Unit * activeStack,
@@ -67,7 +67,8 @@ struct SetGlobalState
 
 #define SET_GLOBAL_STATE(ai) SetGlobalState _hlpSetState(ai)
 
-#define NET_EVENT_HANDLER SET_GLOBAL_STATE(this)
+// network events modify AI memory, they wait for end of current step of turn preparation which reads it
+#define NET_EVENT_HANDLER SET_GLOBAL_STATE(this); std::unique_lock netEventMemoryLock(nullkiller->memoryMutex)
 #define MAKING_TURN SET_GLOBAL_STATE(this)
 
 AIGateway::AIGateway()
@@ -90,6 +91,8 @@ void AIGateway::availableCreaturesChanged(const CGDwelling * town)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	nullkiller->stateChanges->objectChanged(town->id);
 }
 
 void AIGateway::heroMoved(const TryMoveHero & details, bool verbose)
@@ -102,6 +105,8 @@ void AIGateway::heroMoved(const TryMoveHero & details, bool verbose)
 	if(!hero)
 		validateObject(details.id); //enemy hero may have left visible area
 
+	nullkiller->stateChanges->heroMoved(details.id, !hero || cb->getPlayerRelations(hero->tempOwner, playerID) == PlayerRelations::ENEMIES);
+
 	const int3 from = hero ? hero->convertToVisitablePos(details.start) : (details.start - int3(0,1,0));
 	const int3 to   = hero ? hero->convertToVisitablePos(details.end)   : (details.end   - int3(0,1,0));
 
@@ -140,6 +145,14 @@ void AIGateway::heroInGarrisonChange(const CGTownInstance * town)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	trackObjectChange(town->id);
+
+	if(town->garrisonHero)
+		trackObjectChange(town->garrisonHero->id);
+
+	if(town->visitingHero)
+		trackObjectChange(town->visitingHero->id);
 }
 
 void AIGateway::centerView(int3 pos, int focusTime)
@@ -152,12 +165,17 @@ void AIGateway::artifactMoved(const ArtifactLocation & src, const ArtifactLocati
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	trackObjectChange(src.artHolder);
+	trackObjectChange(dst.artHolder);
 }
 
 void AIGateway::artifactAssembled(const ArtifactLocation & al)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	trackObjectChange(al.artHolder);
 }
 
 void AIGateway::showTavernWindow(const CGObjectInstance * object, const CGHeroInstance * visitor, QueryID queryID)
@@ -230,18 +248,24 @@ void AIGateway::artifactPut(const ArtifactLocation & al)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	trackObjectChange(al.artHolder);
 }
 
 void AIGateway::artifactRemoved(const ArtifactLocation & al)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	trackObjectChange(al.artHolder);
 }
 
 void AIGateway::artifactDisassembled(const ArtifactLocation & al)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	trackObjectChange(al.artHolder);
 }
 
 void AIGateway::heroVisit(const CGHeroInstance * visitor, const CGObjectInstance * visitedObj, bool start)
@@ -253,6 +277,10 @@ void AIGateway::heroVisit(const CGHeroInstance * visitor, const CGObjectInstance
 	{
 		nullkiller->memory->markObjectVisited(visitedObj);
 		nullkiller->objectClusterizer->invalidate(visitedObj->id);
+		nullkiller->stateChanges->objectChanged(visitedObj->id);
+
+		if(visitor)
+			trackObjectChange(visitor->id);
 	}
 
 	status.heroVisit(visitedObj, start);
@@ -276,6 +304,7 @@ void AIGateway::tileHidden(const std::unordered_set<int3> & pos)
 	NET_EVENT_HANDLER;
 
 	nullkiller->memory->removeInvisibleObjects(myCb.get());
+	nullkiller->stateChanges->tilesChanged(pos.size());
 }
 
 void AIGateway::tileRevealed(const std::unordered_set<int3> & pos)
@@ -285,8 +314,13 @@ void AIGateway::tileRevealed(const std::unordered_set<int3> & pos)
 	for(int3 tile : pos)
 	{
 		for(const CGObjectInstance * obj : myCb->getVisitableObjs(tile))
+		{
 			addVisitableObj(obj);
+			invalidateObjectGraph(obj);
+		}
 	}
+
+	nullkiller->stateChanges->tilesChanged(pos.size());
 }
 
 void AIGateway::heroExchangeStarted(ObjectInstanceID hero1, ObjectInstanceID hero2, QueryID query)
@@ -329,6 +363,8 @@ void AIGateway::heroPrimarySkillChanged(const CGHeroInstance * hero, PrimarySkil
 {
 	LOG_TRACE_PARAMS(logAi, "which '%i', val '%i'", static_cast<int>(which) % val);
 	NET_EVENT_HANDLER;
+
+	nullkiller->stateChanges->heroChanged(hero->id);
 }
 
 void AIGateway::showRecruitmentDialog(const CGDwelling * dwelling, const CArmedInstance * dst, int level, QueryID queryID)
@@ -348,12 +384,17 @@ void AIGateway::heroMovePointsChanged(const CGHeroInstance * hero)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	nullkiller->stateChanges->heroMoved(hero->id, false);
 }
 
 void AIGateway::garrisonsChanged(ObjectInstanceID id1, ObjectInstanceID id2)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	trackObjectChange(id1);
+	trackObjectChange(id2);
 }
 
 void AIGateway::newObject(const CGObjectInstance * obj)
@@ -361,7 +402,12 @@ void AIGateway::newObject(const CGObjectInstance * obj)
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
 	if(obj->isVisitable())
+	{
 		addVisitableObj(obj);
+		invalidateObjectGraph(obj);
+	}
+
+	nullkiller->stateChanges->objectChanged(obj->id);
 }
 
 //to prevent AI from accessing objects that got deleted while they became invisible (Cover of Darkness, enemy hero moved etc.) below code allows AI to know deletion of objects out of sight
@@ -376,20 +422,26 @@ void AIGateway::objectRemoved(const CGObjectInstance * obj, const PlayerColor &
 
 	nullkiller->memory->removeFromMemory(obj);
 	nullkiller->objectClusterizer->onObjectRemoved(obj->id);
+	nullkiller->stateChanges->objectRemoved(obj->id);
 
-	if(nullkiller->baseGraph && nullkiller->isObjectGraphAllowed())
+	if(nullkiller->isObjectGraphAllowed())
 	{
-		nullkiller->baseGraph->removeObject(obj);
+		std::unique_lock graphLock(Nullkiller::baseGraphMutex);
+
+		if(nullkiller->baseGraph)
+			nullkiller->baseGraph->removeObject(obj);
 	}
 
 	if(obj->ID == Obj::HERO && obj->tempOwner == playerID)
 	{
 		lostHero(cb->getHero(obj->id)); //we can promote, since objectRemoved is called just before actual deletion
+		nullkiller->stateChanges->heroChanged(obj->id);
 	}
 
 	if(obj->ID == Obj::HERO && cb->getPlayerRelations(obj->tempOwner, playerID) == PlayerRelations::ENEMIES)
 	{
 		nullkiller->dangerHitMap->reset();
+		nullkiller->stateChanges->enemyHeroChanged();
 	}
 }
 
@@ -409,12 +461,19 @@ void AIGateway::heroCreated(const CGHeroInstance * h)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	if(h->tempOwner == playerID)
+		nullkiller->stateChanges->heroChanged(h->id);
+	else
+		nullkiller->stateChanges->objectChanged(h->id);
 }
 
 void AIGateway::advmapSpellCast(const CGHeroInstance * caster, SpellID spellID)
 {
 	LOG_TRACE_PARAMS(logAi, "spellID '%i", spellID);
 	NET_EVENT_HANDLER;
+
+	nullkiller->stateChanges->heroChanged(caster->id);
 }
 
 void AIGateway::showInfoDialog(EInfoWindowMode type, const std::string & text, const std::vector<Component> & components, int soundID)
@@ -446,6 +505,8 @@ void AIGateway::receivedResource()
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	nullkiller->stateChanges->resourcesChanged();
 }
 
 void AIGateway::showUniversityWindow(const IMarket * market, const CGHeroInstance * visitor, QueryID queryID)
@@ -461,12 +522,16 @@ void AIGateway::heroManaPointsChanged(const CGHeroInstance * hero)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	nullkiller->stateChanges->heroChanged(hero->id);
 }
 
 void AIGateway::heroSecondarySkillChanged(const CGHeroInstance * hero, int which, int val)
 {
 	LOG_TRACE_PARAMS(logAi, "which '%d', val '%d'", which % val);
 	NET_EVENT_HANDLER;
+
+	nullkiller->stateChanges->heroChanged(hero->id);
 }
 
 void AIGateway::battleResultsApplied()
@@ -487,6 +552,8 @@ void AIGateway::objectPropertyChanged(const SetObjectProperty * sop)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	nullkiller->stateChanges->objectChanged(sop->id);
 	if(sop->what == ObjProperty::OWNER)
 	{
 		auto relations = myCb->getPlayerRelations(playerID, sop->identifier.as<PlayerColor>());
@@ -516,12 +583,16 @@ void AIGateway::buildChanged(const CGTownInstance * town, BuildingID buildingID,
 {
 	LOG_TRACE_PARAMS(logAi, "what '%i'", what);
 	NET_EVENT_HANDLER;
+
+	nullkiller->stateChanges->objectChanged(town->id);
 }
 
 void AIGateway::heroBonusChanged(const CGHeroInstance * hero, const Bonus & bonus, bool gain)
 {
 	LOG_TRACE_PARAMS(logAi, "gain '%i'", gain);
 	NET_EVENT_HANDLER;
+
+	nullkiller->stateChanges->heroChanged(hero->id);
 }
 
 void AIGateway::showMarketWindow(const IMarket * market, const CGHeroInstance * visitor, QueryID queryID)
@@ -580,6 +651,33 @@ void AIGateway::initGameInterface(std::shared_ptr<Environment> env, std::shared_
 	retrieveVisitableObjs();
 }
 
+void AIGateway::playerStartsTurn(PlayerColor player)
+{
+	LOG_TRACE_PARAMS(logAi, "player '%s'", player.toString());
+	NET_EVENT_HANDLER;
+
+	// players act one by one, so our turn is next when no other player in game is between us and the player who just started
+	if(player == playerID || !nullkiller->settings->isTurnPreparationAllowed() || status.haveTurn())
+		return;
+
+	if(cb->getDate(Date::DAY) == 1 || player > playerID)
+		return;
+
+	for(PlayerColor other(player.getNum() + 1); other < playerID; other.advance(1))
+	{
+		if(cb->getPlayerStatus(other, false) == EPlayerStatus::INGAME)
+			return;
+	}
+
+	boost::lock_guard<boost::mutex> preparationGuard(turnPreparationMutex);
+
+	// do not block events handling thread if previous preparation is still running
+	if(preparingTurn && !preparingTurn->try_join_for(boost::chrono::milliseconds(0)))
+		return;
+
+	preparingTurn = std::make_unique<boost::thread>(&AIGateway::prepareTurn, this);
+}
+
 void AIGateway::yourTurn(QueryID queryID)
 {
 	LOG_TRACE_PARAMS(logAi, "queryID '%i'", queryID);
@@ -595,6 +693,8 @@ void AIGateway::heroGotLevel(const CGHeroInstance * hero, PrimarySkill pskill, s
 	LOG_TRACE_PARAMS(logAi, "queryID '%i'", queryID);
 	NET_EVENT_HANDLER;
 
+	nullkiller->stateChanges->heroChanged(hero->id);
+
 	status.addQuery(queryID, boost::str(boost::format("Hero %s got level %d") % hero->getNameTranslated() % hero->level));
 	HeroPtr hPtr = hero;
 
@@ -812,27 +912,28 @@ void AIGateway::makeTurn()
 	auto day = cb->getDate(Date::DAY);
 	logAi->info("Player %d (%s) starting turn, day %d", playerID, playerID.toString(), day);
 
-	boost::shared_lock gsLock(CGameState::mutex);
 	setThreadName("AIGateway::makeTurn");
 
-	if(nullkiller->isOpenMap())
 	{
-		cb->sendMessage("vcmieagles");
+		// state prepared before turn start is reused if it is still valid
+		boost::lock_guard<boost::mutex> preparationGuard(turnPreparationMutex);
+
+		if(preparingTurn)
+		{
+			preparingTurn->join();
+			preparingTurn.reset();
+		}
 	}
 
-	retrieveVisitableObjs();
+	boost::shared_lock gsLock(CGameState::mutex);
 
-	if(cb->getDate(Date::DAY_OF_WEEK) == 1)
+	if(nullkiller->isOpenMap())
 	{
-		for(const CGObjectInstance * obj : nullkiller->memory->visitableObjs)
-		{
-			if(isWeeklyRevisitable(nullkiller.get(), obj))
-			{
-				nullkiller->memory->markObjectUnvisited(obj);
-			}
-		}
+		cb->sendMessage("vcmieagles");
 	}
 
+	updateMemory();
+
 #if NKAI_TRACE_LEVEL == 0
 	try
 	{
@@ -859,6 +960,9 @@ void AIGateway::makeTurn()
 	}
 #endif
 
+	// several AI players may wait for their turns, path nodes of each one are only needed during its turn
+	nullkiller->releaseMemory();
+
 	endTurn();
 }
 
@@ -1167,6 +1271,9 @@ void AIGateway::battleStart(const BattleID & battleID, const CCreatureSet * army
 void AIGateway::battleEnd(const BattleID & battleID, const BattleResult * br, QueryID queryID)
 {
 	NET_EVENT_HANDLER;
+
+	// battle may change armies of both sides and remove objects
+	nullkiller->stateChanges->invalidateAll();
 	assert(status.getBattle() == ONGOING_BATTLE);
 	status.setBattle(ENDING_BATTLE);
 	bool won = br->winner == myCb->getBattle(battleID)->battleGetMySide();
@@ -1193,6 +1300,22 @@ void AIGateway::waitTillFree()
 	status.waitTillFree();
 }
 
+void AIGateway::updateMemory()
+{
+	retrieveVisitableObjs();
+
+	if(cb->getDate(Date::DAY_OF_WEEK) == 1)
+	{
+		for(const CGObjectInstance * obj : nullkiller->memory->visitableObjs)
+		{
+			if(isWeeklyRevisitable(nullkiller.get(), obj))
+			{
+				nullkiller->memory->markObjectUnvisited(obj);
+			}
+		}
+	}
+}
+
 void AIGateway::retrieveVisitableObjs()
 {
 	foreach_tile_pos([&](const int3 & pos)
@@ -1215,6 +1338,36 @@ std::vector<const CGObjectInstance *> AIGateway::getFlaggedObjects() const
 	return ret;
 }
 
+void AIGateway::trackObjectChange(ObjectInstanceID id)
+{
+	if(id == ObjectInstanceID::NONE)
+		return;
+
+	auto obj = cb->getObj(id, false);
+
+	if(obj && obj->ID == Obj::HERO && obj->tempOwner == playerID)
+		nullkiller->stateChanges->heroChanged(id);
+	else
+		nullkiller->stateChanges->objectChanged(id);
+}
+
+void AIGateway::invalidateObjectGraph(const CGObjectInstance * obj)
+{
+	// heroes are connected to graph separately on each update
+	if(obj->ID == Obj::HERO || obj->ID == Obj::EVENT)
+		return;
+
+	if(!nullkiller->isObjectGraphAllowed())
+		return;
+
+	std::unique_lock graphLock(Nullkiller::baseGraphMutex);
+
+	if(nullkiller->baseGraph && !nullkiller->baseGraph->hasNodeAt(obj->visitablePos()))
+	{
+		nullkiller->baseGraph->invalidate();
+	}
+}
+
 void AIGateway::addVisitableObj(const CGObjectInstance * obj)
 {
 	if(obj->ID == Obj::EVENT)
@@ -1561,6 +1714,40 @@ void AIGateway::finish()
 		makingTurn->join();
 		makingTurn.reset();
 	}
+
+	boost::lock_guard<boost::mutex> preparationGuard(turnPreparationMutex);
+
+	if(preparingTurn)
+	{
+		preparingTurn->interrupt();
+		preparingTurn->join();
+		preparingTurn.reset();
+	}
+}
+
+void AIGateway::prepareTurn()
+{
+	SET_GLOBAL_STATE(this);
+	setThreadName("AIGateway::prepareTurn");
+
+	try
+	{
+		boost::shared_lock gsLock(CGameState::mutex);
+		std::unique_lock memoryLock(nullkiller->memoryMutex, std::defer_lock);
+
+		Nullkiller::lockInterruptibly(memoryLock);
+		updateMemory();
+		nullkiller->prepareTurn(memoryLock);
+	}
+	catch(boost::thread_interrupted & e)
+	{
+		(void)e;
+		logAi->debug("Turn preparation has been interrupted.");
+	}
+	catch(std::exception & e)
+	{
+		logAi->debug("Turn preparation has caught an exception: %s", e.what());
+	}
 }
 
 void AIGateway::requestActionASAP(std::function<void()> whatToDo)
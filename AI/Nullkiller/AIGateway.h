@@ -82,8 +82,10 @@ public:
 	std::string battlename;
 	std::shared_ptr<CCallback> myCb;
 	std::unique_ptr<boost::thread> makingTurn;
+	std::unique_ptr<boost::thread> preparingTurn;
 private:
 	boost::mutex turnInterruptionMutex;
+	boost::mutex turnPreparationMutex;
 
 public:
 	ObjectInstanceID selectedObject;
@@ -100,6 +102,7 @@ public:
 	std::string getBattleAIName() const override;
 
 	void initGameInterface(std::shared_ptr<Environment> env, std::shared_ptr<CCallback> CB) override;
+	void playerStartsTurn(PlayerColor player) override;
 	void yourTurn(QueryID queryID) override;
 
 	void heroGotLevel(const CGHeroInstance * hero, PrimarySkill pskill, std::vector<SecondarySkill> & skills, QueryID queryID) override; //pskill is gained primary skill, interface has to choose one of given skills and call callback with selection id
@@ -160,6 +163,7 @@ public:
 	void battleEnd(const BattleID & battleID, const BattleResult * br, QueryID queryID) override;
 
 	void makeTurn();
+	void prepareTurn();
 
 	void buildArmyIn(const CGTownInstance * t);
 	void endTurn();
@@ -179,10 +183,13 @@ public:
 	void waitTillFree();
 
 	void addVisitableObj(const CGObjectInstance * obj);
+	void trackObjectChange(ObjectInstanceID id);
+	void invalidateObjectGraph(const CGObjectInstance * obj);
 
 	void validateObject(const CGObjectInstance * obj); //checks if object is still visible and if not, removes references to it
 	void validateObject(ObjectIdRef obj); //checks if object is still visible and if not, removes references to it
 	void retrieveVisitableObjs();
+	void updateMemory();
 	virtual std::vector<const CGObjectInstance *> getFlaggedObjects() const;
 
 	void requestSent(const CPackForServer * pack, int requestID) override;
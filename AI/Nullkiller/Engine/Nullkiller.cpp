@@ -24,6 +24,9 @@
 #include "../Goals/Composition.h"
 #include "../../../lib/CPlayerState.h"
 #include "../../lib/StartInfo.h"
+#include "../../lib/ScopeGuard.h"
+#include "../../lib/UnlockGuard.h"
+#include "../../lib/gameState/CGameState.h"
 
 namespace NKAI
 {
@@ -32,11 +35,14 @@ using namespace Goals;
 
 // while we play vcmieagles graph can be shared
 std::unique_ptr<ObjectGraph> Nullkiller::baseGraph;
+std::shared_mutex Nullkiller::baseGraphMutex;
+int Nullkiller::baseGraphWeek = 0;
 
 Nullkiller::Nullkiller()
-	:activeHero(nullptr), scanDepth(ScanDepth::MAIN_FULL), useHeroChain(true)
+	:activeHero(nullptr), scanDepth(ScanDepth::MAIN_FULL), useHeroChain(true), preparedDay(-1), preparationLock(nullptr)
 {
 	memory = std::make_unique<AIMemory>();
+	stateChanges = std::make_unique<StateChangeTracker>();
 	settings = std::make_unique<Settings>();
 
 	useObjectGraph = settings->isObjectGraphAllowed();
@@ -78,7 +84,11 @@ void Nullkiller::init(std::shared_ptr<CCallback> cb, AIGateway * gateway)
 		openMap = false;
 	}
 
-	baseGraph.reset();
+	{
+		std::unique_lock graphLock(baseGraphMutex);
+
+		baseGraph.reset();
+	}
 
 	priorityEvaluator.reset(new PriorityEvaluator(this));
 	priorityEvaluators.reset(
@@ -224,14 +234,108 @@ void Nullkiller::resetAiState()
 	dangerHitMap->reset();
 	useHeroChain = true;
 	objectClusterizer->reset();
+	stateChanges->turnStarted();
+
+	if(isObjectGraphAllowed())
+	{
+		// graph is shared by all AI players, another player may be preparing its turn
+		std::unique_lock graphLock(baseGraphMutex);
+
+		if(isBaseGraphOutdated())
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			if(!baseGraph)
+				baseGraph = std::make_unique<ObjectGraph>();
+
+			baseGraph->updateGraph(this);
+			baseGraphWeek = cb->getDate(Date::WEEK);
+
+			logAi->debug("Object graph rebuilt in %ld", timeElapsed(start));
+		}
+	}
+}
+
+bool Nullkiller::isBaseGraphOutdated() const
+{
+	// full rebuild also invalidates graph paths of all heroes, so it is done at most once per week:
+	// objects found during a week are added on the next one, together with grown danger of guards
+	return !baseGraph || (baseGraph->isOutdated() && baseGraphWeek != cb->getDate(Date::WEEK));
+}
+
+void Nullkiller::prepareTurn(std::unique_lock<std::recursive_timed_mutex> & memoryLock)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	preparedDay = -1;
+	preparationLock = &memoryLock;
+
+	auto clearLock = vstd::makeScopeGuard([this]()
+	{
+		preparationLock = nullptr;
+	});
+
+	resetAiState();
+	updateAiState(1);
+
+	preparedDay = cb->getDate(Date::DAY);
+
+	logAi->debug("Player %s prepared turn in %ld", playerID.toString(), timeElapsed(start));
+}
+
+void Nullkiller::lockInterruptibly(std::unique_lock<std::recursive_timed_mutex> & lock)
+{
+	while(!lock.try_lock_for(std::chrono::milliseconds(10)))
+		boost::this_thread::interruption_point();
+}
+
+void Nullkiller::finishStep() const
+{
+	boost::this_thread::interruption_point();
+
+	if(!preparationLock)
+		return;
+
+	// Preparation runs while another player acts. Game state and memory are released between steps
+	// so network thread is not blocked for whole preparation. Changes it makes are collected by state change tracker
+	auto removedObjects = stateChanges->getRemovedObjectsCount();
+
+	preparationLock->unlock();
+	{
+		auto unlockGameState = vstd::makeUnlockSharedGuard(CGameState::mutex);
+		boost::this_thread::yield();
+	}
+	lockInterruptibly(*preparationLock);
 
-	if(!baseGraph && isObjectGraphAllowed())
+	// heroes and objects referenced by partially calculated state may have been deleted, turn is prepared again when it starts
+	if(removedObjects != stateChanges->getRemovedObjectsCount())
 	{
-		baseGraph = std::make_unique<ObjectGraph>();
-		baseGraph->updateGraph(this);
+		stateChanges->invalidateAll();
+		throw std::runtime_error("objects used by turn preparation were removed");
 	}
 }
 
+void Nullkiller::releaseMemory()
+{
+	pathfinder->releaseMemory();
+}
+
+bool Nullkiller::isPreparedTurnValid() const
+{
+	if(preparedDay != cb->getDate(Date::DAY))
+		return false;
+
+	if(isObjectGraphAllowed())
+	{
+		std::shared_lock graphLock(baseGraphMutex);
+
+		if(isBaseGraphOutdated())
+			return false;
+	}
+
+	return true;
+}
+
 void Nullkiller::updateAiState(int pass, bool fast)
 {
 	boost::this_thread::interruption_point();
@@ -248,14 +352,34 @@ void Nullkiller::updateAiState(int pass, bool fast)
 
 	if(!fast)
 	{
+		// fast passes do not use paths, so changes are kept until next full update
+		StateChanges changes = stateChanges->takeChanges();
+		uint64_t hitMapTime = 0;
+		uint64_t heroesTime = 0;
+		uint64_t pathsTime = 0;
+		uint64_t graphsTime = 0;
+		uint64_t clustersTime = 0;
+
+		auto stepStart = std::chrono::high_resolution_clock::now();
+
 		memory->removeInvisibleObjects(cb.get());
 
+		if(changes.enemyHeroes)
+			dangerHitMap->reset();
+
 		dangerHitMap->updateHitMap();
 		dangerHitMap->calculateTileOwners();
+		hitMapTime = timeElapsed(stepStart);
 
-		boost::this_thread::interruption_point();
+		finishStep();
+
+		stepStart = std::chrono::high_resolution_clock::now();
+
+		if(changes.affectsHeroes())
+			heroManager->update();
+
+		heroesTime = timeElapsed(stepStart);
 
-		heroManager->update();
 		logAi->trace("Updating paths");
 
 		std::map<const CGHeroInstance *, HeroRole> activeHeroes;
@@ -282,21 +406,57 @@ void Nullkiller::updateAiState(int pass, bool fast)
 			cfg.scoutTurnDistanceLimit =settings->getScoutHeroTurnDistanceLimit();
 		}
 
-		boost::this_thread::interruption_point();
+		finishStep();
+
+		stepStart = std::chrono::high_resolution_clock::now();
+
+		// paths of all heroes are calculated together because of hero chains, so any change requires full recalculation
+		bool pathsUpdated = changes.affectsPaths(cfg.useHeroChain) || !pathfinder->arePathsCalculated(activeHeroes, cfg);
+
+		if(pathsUpdated)
+			pathfinder->updatePaths(activeHeroes, cfg);
 
-		pathfinder->updatePaths(activeHeroes, cfg);
+		// tracked even while graph is not used so it is correct once graph becomes allowed
+		pathfinder->updateHeroLinks(changes, pathsUpdated);
+		pathsTime = timeElapsed(stepStart);
 
 		if(isObjectGraphAllowed())
 		{
-			pathfinder->updateGraphs(
-				activeHeroes,
-				scanDepth == ScanDepth::SMALL ? 255 : 10,
-				scanDepth == ScanDepth::ALL_FULL ? 255 : 3);
+			stepStart = std::chrono::high_resolution_clock::now();
+
+			uint8_t mainScanDepth = scanDepth == ScanDepth::SMALL ? 255 : 10;
+			uint8_t scoutScanDepth = scanDepth == ScanDepth::ALL_FULL ? 255 : 3;
+
+			// graph of each hero is connected to all other heroes using their regular paths, which are calculated
+			// together for all heroes because of hero chains, so any change of paths outdates graphs of all heroes
+			// through links version, otherwise graph of a hero is recalculated only when hero itself changed
+			pathfinder->updateGraphs(activeHeroes, mainScanDepth, scoutScanDepth);
+			graphsTime = timeElapsed(stepStart);
 		}
 
-		boost::this_thread::interruption_point();
+		finishStep();
+
+		stepStart = std::chrono::high_resolution_clock::now();
+
+		for(auto id : changes.objects)
+		{
+			if(cb->getObj(id, false))
+				objectClusterizer->invalidate(id);
+		}
 
 		objectClusterizer->clusterize();
+		clustersTime = timeElapsed(stepStart);
+
+		logAi->debug(
+			"Pass %d state changes: %s. Hit map %ld, heroes %ld, paths %ld%s, graphs %ld, clusters %ld",
+			pass,
+			changes.toString(),
+			hitMapTime,
+			heroesTime,
+			pathsTime,
+			pathsUpdated ? "" : " (reused)",
+			graphsTime,
+			clustersTime);
 	}
 
 	armyManager->update();
@@ -344,12 +504,20 @@ HeroLockedReason Nullkiller::getHeroLockedReason(const CGHeroInstance * hero) co
 
 void Nullkiller::makeTurn()
 {
-	boost::lock_guard<boost::mutex> sharedStorageLock(AISharedStorage::locker);
-
 	const int MAX_DEPTH = 10;
 	const float FAST_TASK_MINIMAL_PRIORITY = 0.7f;
 
-	resetAiState();
+	if(isPreparedTurnValid())
+	{
+		// changes received since preparation are applied incrementally by first pass
+		logAi->debug("Using state prepared before turn start");
+	}
+	else
+	{
+		resetAiState();
+	}
+
+	preparedDay = -1;
 
 	Goals::TGoalVec bestTasks;
 
@@ -14,6 +14,7 @@
 #include "Settings.h"
 #include "AIMemory.h"
 #include "DeepDecomposer.h"
+#include "StateChangeTracker.h"
 #include "../Analyzers/DangerHitMapAnalyzer.h"
 #include "../Analyzers/BuildAnalyzer.h"
 #include "../Analyzers/ArmyManager.h"
@@ -78,9 +79,15 @@ private:
 	AIGateway * gateway;
 	bool openMap;
 	bool useObjectGraph;
+	std::atomic<int> preparedDay;
+	/// lock of memory mutex held by turn preparation, released between steps of state update
+	std::unique_lock<std::recursive_timed_mutex> * preparationLock;
+	static int baseGraphWeek;
 
 public:
 	static std::unique_ptr<ObjectGraph> baseGraph;
+	/// guards base graph, it is shared by all AI players and players may prepare turns in parallel
+	static std::shared_mutex baseGraphMutex;
 
 	std::unique_ptr<DangerHitMapAnalyzer> dangerHitMap;
 	std::unique_ptr<BuildAnalyzer> buildAnalyzer;
@@ -91,6 +98,7 @@ public:
 	std::unique_ptr<HeroManager> heroManager;
 	std::unique_ptr<ArmyManager> armyManager;
 	std::unique_ptr<AIMemory> memory;
+	std::unique_ptr<StateChangeTracker> stateChanges;
 	std::unique_ptr<FuzzyHelper> dangerEvaluator;
 	std::unique_ptr<DeepDecomposer> decomposer;
 	std::unique_ptr<ArmyFormation> armyFormation;
@@ -98,10 +106,19 @@ public:
 	PlayerColor playerID;
 	std::shared_ptr<CCallback> cb;
 	std::mutex aiStateMutex;
+	/// held by turn preparation while it uses AI memory and analyzers, network event handlers lock it before modifying them
+	std::recursive_timed_mutex memoryMutex;
 
 	Nullkiller();
 	void init(std::shared_ptr<CCallback> cb, AIGateway * gateway);
 	void makeTurn();
+	/// calculates state of upcoming turn while other players act, makeTurn reuses it unless a new day has started
+	/// expects game state to be locked for reading and memory mutex to be locked by given lock, both are released between steps
+	void prepareTurn(std::unique_lock<std::recursive_timed_mutex> & memoryLock);
+	/// frees path nodes allocated during turn, they are allocated again by next pathfinding
+	void releaseMemory();
+	/// locks memory mutex while allowing thread to be interrupted, e.g. by network thread handler which holds memory mutex
+	static void lockInterruptibly(std::unique_lock<std::recursive_timed_mutex> & lock);
 	bool isActive(const CGHeroInstance * hero) const { return activeHero == hero; }
 	bool isHeroLocked(const CGHeroInstance * hero) const;
 	HeroPtr getActiveHero() { return activeHero; }
@@ -120,10 +137,15 @@ public:
 	ScanDepth getScanDepth() const { return scanDepth; }
 	bool isOpenMap() const { return openMap; }
 	bool isObjectGraphAllowed() const { return useObjectGraph; }
+	/// checks for interruption and, during turn preparation, lets other threads modify game state and AI memory
+	/// called between steps of state update and between passes of long steps, throws if objects were removed meanwhile
+	void finishStep() const;
 
 private:
 	void resetAiState();
 	void updateAiState(int pass, bool fast = false);
+	bool isBaseGraphOutdated() const;
+	bool isPreparedTurnValid() const;
 	void decompose(Goals::TGoalVec & result, Goals::TSubgoal behavior, int decompositionMaxDepth) const;
 	Goals::TTask choseBestTask(Goals::TGoalVec & tasks) const;
 	Goals::TTaskVec buildPlan(Goals::TGoalVec & tasks) const;
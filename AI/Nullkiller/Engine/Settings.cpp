@@ -30,7 +30,8 @@ namespace NKAI
 		maxpass(10),
 		allowObjectGraph(true),
 		useTroopsFromGarrisons(false),
-		openMap(true)
+		openMap(true),
+		allowTurnPreparation(true)
 	{
 		JsonNode node = JsonUtils::assembleFromFiles("config/ai/nkai/nkai-settings");
 
@@ -73,5 +74,10 @@ namespace NKAI
 		{
 			useTroopsFromGarrisons = node.Struct()["useTroopsFromGarrisons"].Bool();
 		}
+
+		if(!node.Struct()["allowTurnPreparation"].isNull())
+		{
+			allowTurnPreparation = node.Struct()["allowTurnPreparation"].Bool();
+		}
 	}
 }
@@ -0,0 +1,137 @@
+/*
+* StateChangeTracker.cpp, part of VCMI engine
+*
+* Authors: listed in file AUTHORS in main folder
+*
+* License: GNU General Public License v2.0 or later
+* Full text of license available in license.txt file, in main folder
+*
+*/
+#include "../StdInc.h"
+#include "StateChangeTracker.h"
+
+namespace NKAI
+{
+
+bool StateChanges::empty() const
+{
+	return !everything && !newTurn && !enemyHeroes && !resources && !changedTiles && heroes.empty() && movedHeroes.empty() && objects.empty();
+}
+
+bool StateChanges::affectsHeroes() const
+{
+	return everything || newTurn || !heroes.empty();
+}
+
+bool StateChanges::affectsMap() const
+{
+	return everything || changedTiles || !objects.empty();
+}
+
+bool StateChanges::affectsPaths(bool useHeroChain) const
+{
+	return affectsHeroes() || affectsMap() || enemyHeroes || !movedHeroes.empty() || (resources && useHeroChain);
+}
+
+std::string StateChanges::toString() const
+{
+	if(everything)
+		return "full update";
+
+	return boost::str(boost::format("%s%d heroes, %d moved heroes, %d objects, %d tiles%s%s")
+		% (newTurn ? "new turn, " : "")
+		% heroes.size()
+		% movedHeroes.size()
+		% objects.size()
+		% changedTiles
+		% (enemyHeroes ? ", enemy heroes" : "")
+		% (resources ? ", resources" : ""));
+}
+
+void StateChangeTracker::heroChanged(ObjectInstanceID hero)
+{
+	std::lock_guard<std::mutex> lock(changesMutex);
+
+	changes.heroes.insert(hero);
+}
+
+void StateChangeTracker::heroMoved(ObjectInstanceID hero, bool enemy)
+{
+	std::lock_guard<std::mutex> lock(changesMutex);
+
+	changes.movedHeroes.insert(hero);
+
+	if(enemy)
+		changes.enemyHeroes = true;
+}
+
+void StateChangeTracker::objectChanged(ObjectInstanceID object)
+{
+	std::lock_guard<std::mutex> lock(changesMutex);
+
+	changes.objects.insert(object);
+}
+
+void StateChangeTracker::objectRemoved(ObjectInstanceID object)
+{
+	std::lock_guard<std::mutex> lock(changesMutex);
+
+	changes.objects.insert(object);
+	removedObjects++;
+}
+
+void StateChangeTracker::enemyHeroChanged()
+{
+	std::lock_guard<std::mutex> lock(changesMutex);
+
+	changes.enemyHeroes = true;
+}
+
+void StateChangeTracker::tilesChanged(size_t count)
+{
+	std::lock_guard<std::mutex> lock(changesMutex);
+
+	changes.changedTiles += count;
+}
+
+void StateChangeTracker::resourcesChanged()
+{
+	std::lock_guard<std::mutex> lock(changesMutex);
+
+	changes.resources = true;
+}
+
+void StateChangeTracker::turnStarted()
+{
+	std::lock_guard<std::mutex> lock(changesMutex);
+
+	changes.newTurn = true;
+}
+
+void StateChangeTracker::invalidateAll()
+{
+	std::lock_guard<std::mutex> lock(changesMutex);
+
+	changes.everything = true;
+}
+
+StateChanges StateChangeTracker::takeChanges()
+{
+	std::lock_guard<std::mutex> lock(changesMutex);
+
+	StateChanges result = std::move(changes);
+
+	changes = StateChanges();
+	changes.everything = false;
+
+	return result;
+}
+
+uint32_t StateChangeTracker::getRemovedObjectsCount() const
+{
+	std::lock_guard<std::mutex> lock(changesMutex);
+
+	return removedObjects;
+}
+
+}
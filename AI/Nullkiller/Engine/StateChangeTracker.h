@@ -0,0 +1,67 @@
+/*
+* StateChangeTracker.h, part of VCMI engine
+*
+* Authors: listed in file AUTHORS in main folder
+*
+* License: GNU General Public License v2.0 or later
+* Full text of license available in license.txt file, in main folder
+*
+*/
+#pragma once
+
+#include "../AIUtility.h"
+
+namespace NKAI
+{
+
+/// Changes of game state received by AI since previous update of AI state
+struct StateChanges
+{
+	/// our heroes which gained or lost army, artifacts, skills or were created/lost
+	std::set<ObjectInstanceID> heroes;
+	/// heroes (any owner) which changed position or movement points
+	std::set<ObjectInstanceID> movedHeroes;
+	/// objects which appeared, disappeared, were visited or changed owner
+	std::set<ObjectInstanceID> objects;
+	uint32_t changedTiles = 0;
+	bool enemyHeroes = false;
+	bool resources = false;
+	/// movement points of all heroes were restored, map itself is not affected
+	bool newTurn = false;
+	bool everything = true;
+
+	bool empty() const;
+	bool affectsHeroes() const;
+	/// resources only affect paths through army purchases of hero chains
+	bool affectsPaths(bool useHeroChain) const;
+	bool affectsMap() const;
+	std::string toString() const;
+};
+
+/// Collects changes reported to AI by game events, so only affected parts of AI state are recalculated
+class StateChangeTracker
+{
+private:
+	mutable std::mutex changesMutex;
+	StateChanges changes;
+	/// not reset by takeChanges, lets long calculations detect that objects they use may no longer exist
+	uint32_t removedObjects = 0;
+
+public:
+	void heroChanged(ObjectInstanceID hero);
+	void heroMoved(ObjectInstanceID hero, bool enemy);
+	void objectChanged(ObjectInstanceID object);
+	void objectRemoved(ObjectInstanceID object);
+	void enemyHeroChanged();
+	void tilesChanged(size_t count);
+	void resourcesChanged();
+	void turnStarted();
+	void invalidateAll();
+
+	/// returns all changes collected so far and starts collecting from scratch
+	StateChanges takeChanges();
+	/// number of objects removed since start of the game
+	uint32_t getRemovedObjectsCount() const;
+};
+
+}
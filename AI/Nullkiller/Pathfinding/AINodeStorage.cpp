@@ -25,11 +25,6 @@
 namespace NKAI
 {
 
-std::shared_ptr<boost::multi_array<AIPathNode, 4>> AISharedStorage::shared;
-uint32_t AISharedStorage::version = 0;
-boost::mutex AISharedStorage::locker;
-std::set<int3> committedTiles;
-std::set<int3> committedTilesInitial;
 
 
 const uint64_t FirstActorMask = 1;
@@ -39,36 +34,89 @@ const uint64_t CHAIN_MAX_DEPTH = 4;
 
 const bool DO_NOT_SAVE_TO_COMMITTED_TILES = false;
 
+AISharedStorage::NodePool::NodePool(int3 sizes)
+	:tiles(boost::extents[sizes.z][sizes.x][sizes.y])
+{
+}
+
 AISharedStorage::AISharedStorage(int3 sizes)
+	:pool(std::make_unique<NodePool>(sizes)), version(0)
 {
-	if(!shared){
-		shared.reset(new boost::multi_array<AIPathNode, 4>(
-			boost::extents[sizes.z][sizes.x][sizes.y][AIPathfinding::NUM_CHAINS]));
+}
 
-		nodes = shared;
+AISharedStorage::~AISharedStorage() = default;
 
-		foreach_tile_pos([&](const int3 & pos)
-			{
-				for(auto i = 0; i < AIPathfinding::NUM_CHAINS; i++)
-				{
-					auto & node = get(pos)[i];
-						
-					node.version = -1;
-					node.coord = pos;
-				}
-			});
+AIPathNode * AISharedStorage::allocateChunk(const int3 & tile)
+{
+	AIPathNode * chunk;
+
+	{
+		// hero chain is calculated for different tiles in parallel
+		std::lock_guard<std::mutex> lock(pool->allocationMutex);
+
+		if(pool->poolVersion != version)
+		{
+			pool->poolVersion = version;
+			pool->usedChunks = 0;
+		}
+
+		auto page = pool->usedChunks / CHUNKS_PER_PAGE;
+
+		if(page == pool->pages.size())
+			pool->pages.push_back(std::make_unique<AIPathNode[]>(CHUNKS_PER_PAGE * AIPathfinding::BUCKET_SIZE));
+
+		chunk = &pool->pages[page][(pool->usedChunks % CHUNKS_PER_PAGE) * AIPathfinding::BUCKET_SIZE];
+		pool->usedChunks++;
 	}
-	else
-		nodes = shared;
+
+	for(int i = 0; i < AIPathfinding::BUCKET_SIZE; i++)
+	{
+		chunk[i].version = -1;
+		chunk[i].coord = tile;
+	}
+
+	return chunk;
 }
 
-AISharedStorage::~AISharedStorage()
+AIPathNode * AISharedStorage::getOrCreateBucket(const int3 & tile, int bucket)
 {
-	nodes.reset();
-	if(shared && shared.use_count() == 1)
+	TileChunks & chunks = pool->tiles[tile.z][tile.x][tile.y];
+
+	if(chunks.version != version)
 	{
-		shared.reset();
+		chunks = TileChunks();
+		chunks.version = version;
 	}
+
+	if(!chunks.buckets[bucket])
+		chunks.buckets[bucket] = allocateChunk(tile);
+
+	return chunks.buckets[bucket];
+}
+
+void AISharedStorage::releasePages()
+{
+	std::lock_guard<std::mutex> lock(pool->allocationMutex);
+
+	// tiles of current version point into released pages
+	version++;
+	pool->pages.clear();
+	pool->pages.shrink_to_fit();
+	pool->usedChunks = 0;
+}
+
+size_t AISharedStorage::getAllocatedMemory() const
+{
+	return pool->tiles.num_elements() * sizeof(TileChunks)
+		+ pool->pages.size() * CHUNKS_PER_PAGE * AIPathfinding::BUCKET_SIZE * sizeof(AIPathNode);
+}
+
+size_t AISharedStorage::getUsedMemory() const
+{
+	size_t usedChunks = pool->poolVersion == version ? pool->usedChunks : 0;
+
+	return pool->tiles.num_elements() * sizeof(TileChunks)
+		+ usedChunks * AIPathfinding::BUCKET_SIZE * sizeof(AIPathNode);
 }
 
 void AIPathNode::addSpecialAction(std::shared_ptr<const SpecialAction> action)
@@ -106,7 +154,7 @@ void AINodeStorage::initialize(const PathfinderOptions & options, const CGameSta
 	if(heroChainPass != EHeroChainPass::INITIAL)
 		return;
 
-	AISharedStorage::version++;
+	nodes.nextVersion();
 
 	//TODO: fix this code duplication with NodeStorage::initialize, problem is to keep `resetTile` inline
 	const PlayerColor fowPlayer = ai->playerID;
@@ -164,28 +212,36 @@ void AINodeStorage::clear()
 	turnDistanceLimit[HeroRole::SCOUT] = 255;
 }
 
+void AINodeStorage::releaseMemory()
+{
+	clear();
+	heroChain.clear();
+	heroChain.shrink_to_fit();
+	nodes.releasePages();
+}
+
 std::optional<AIPathNode *> AINodeStorage::getOrCreateNode(
 	const int3 & pos, 
 	const EPathfindingLayer layer, 
 	const ChainActor * actor)
 {
 	int bucketIndex = ((uintptr_t)actor + static_cast<uint32_t>(layer)) % AIPathfinding::BUCKET_COUNT;
-	int bucketOffset = bucketIndex * AIPathfinding::BUCKET_SIZE;
-	auto chains = nodes.get(pos);
 
 	if(blocked(pos, layer))
 	{
 		return std::nullopt;
 	}
 
+	AIPathNode * chains = nodes.getOrCreateBucket(pos, bucketIndex);
+
 	for(auto i = AIPathfinding::BUCKET_SIZE - 1; i >= 0; i--)
 	{
-		AIPathNode & node = chains[i + bucketOffset];
+		AIPathNode & node = chains[i];
 
-		if(node.version != AISharedStorage::version)
+		if(node.version != nodes.getVersion())
 		{
 			node.reset(layer, getAccessibility(pos, layer));
-			node.version = AISharedStorage::version;
+			node.version = nodes.getVersion();
 			node.actor = actor;
 
 			return &node;
@@ -707,7 +763,7 @@ void HeroChainCalculationTask::calculateHeroChain(
 {
 	for(AIPathNode * node : variants)
 	{
-		if(node == srcNode || !node->actor || node->version != AISharedStorage::version)
+		if(node == srcNode || !node->actor)
 			continue;
 
 		if((node->actor->chainMask & chainMask) == 0 && (srcNode->actor->chainMask & chainMask) == 0)
@@ -1379,78 +1435,70 @@ bool AINodeStorage::isOtherChainBetter(
 
 bool AINodeStorage::isTileAccessible(const HeroPtr & hero, const int3 & pos, const EPathfindingLayer layer) const
 {
-	auto chains = nodes.get(pos);
-
-	for(const AIPathNode & node : chains)
-	{
-		if(node.version == AISharedStorage::version
-			&& node.layer == layer
-			&& node.action != EPathNodeAction::UNKNOWN 
-			&& node.actor
-			&& node.actor->hero == hero.h)
+	return nodes.iterateNodesUntil(pos, [&hero, layer](const AIPathNode & node) -> bool
 		{
-			return true;
-		}
-	}
-
-	return false;
+			return node.layer == layer
+				&& node.action != EPathNodeAction::UNKNOWN
+				&& node.actor
+				&& node.actor->hero == hero.h;
+		});
 }
 
 void AINodeStorage::calculateChainInfo(std::vector<AIPath> & paths, const int3 & pos, bool isOnLand) const
 {
 	auto layer = isOnLand ? EPathfindingLayer::LAND : EPathfindingLayer::SAIL;
-	auto chains = nodes.get(pos);
 
-	for(const AIPathNode & node : chains)
-	{
-		if(node.version != AISharedStorage::version
-			|| node.layer != layer
-			|| node.action == EPathNodeAction::UNKNOWN
-			|| !node.actor
-			|| !node.actor->hero)
+	nodes.iterateNodesUntil(pos, [&](const AIPathNode & node) -> bool
 		{
-			continue;
-		}
+			if(node.layer != layer
+				|| node.action == EPathNodeAction::UNKNOWN
+				|| !node.actor
+				|| !node.actor->hero)
+			{
+				return false;
+			}
 
-		AIPath & path = paths.emplace_back();
+			AIPath & path = paths.emplace_back();
 
-		path.targetHero = node.actor->hero;
-		path.heroArmy = node.actor->creatureSet;
-		path.armyLoss = node.armyLoss;
-		path.targetObjectDanger = ai->dangerEvaluator->evaluateDanger(pos, path.targetHero, !node.actor->allowBattle);
+			path.targetHero = node.actor->hero;
+			path.heroArmy = node.actor->creatureSet;
+			path.armyLoss = node.armyLoss;
+			path.targetObjectDanger = ai->dangerEvaluator->evaluateDanger(pos, path.targetHero, !node.actor->allowBattle);
 
-		if(path.targetObjectDanger > 0)
-		{
-			if(node.theNodeBefore)
+			if(path.targetObjectDanger > 0)
 			{
-				auto prevNode = getAINode(node.theNodeBefore);
-
-				if(node.coord == prevNode->coord && node.actor->hero == prevNode->actor->hero)
+				if(node.theNodeBefore)
 				{
-					paths.pop_back();
-					continue;
+					auto prevNode = getAINode(node.theNodeBefore);
+
+					if(node.coord == prevNode->coord && node.actor->hero == prevNode->actor->hero)
+					{
+						paths.pop_back();
+						return false;
+					}
+					else
+					{
+						path.armyLoss = prevNode->armyLoss;
+					}
 				}
 				else
 				{
-					path.armyLoss = prevNode->armyLoss;
+					path.armyLoss = 0;
 				}
 			}
-			else
-			{
-				path.armyLoss = 0;
-			}
-		}
 
-		path.targetObjectArmyLoss = evaluateArmyLoss(
-			path.targetHero,
-			getHeroArmyStrengthWithCommander(path.targetHero, path.heroArmy),
-			path.targetObjectDanger);
+			path.targetObjectArmyLoss = evaluateArmyLoss(
+				path.targetHero,
+				getHeroArmyStrengthWithCommander(path.targetHero, path.heroArmy),
+				path.targetObjectDanger);
 
-		path.chainMask = node.actor->chainMask;
-		path.exchangeCount = node.actor->actorExchangeCount;
-		
-		fillChainInfo(&node, path, -1);
-	}
+			path.chainMask = node.actor->chainMask;
+			path.exchangeCount = node.actor->actorExchangeCount;
+			
+			fillChainInfo(&node, path, -1);
+
+			return false;
+		});
 }
 
 void AINodeStorage::fillChainInfo(const AIPathNode * node, AIPath & path, int parentIndex) const
@@ -147,24 +147,85 @@ enum EHeroChainPass
 	FINAL // same as SINGLE but for heroes from CHAIN pass
 };
 
+/// Chain nodes of a tile are allocated in chunks, one chunk of BUCKET_SIZE nodes per used bucket.
+/// Chunks are taken from a pool on first use in current version, so memory depends on number of tiles
+/// reached by actors instead of map size multiplied by NUM_CHAINS.
+/// Each AI player owns its storage so players are able to calculate paths at the same time.
 class AISharedStorage
 {
-	// 1-3 - position on map[z][x][y]
-	// 4 - chain + layer (normal, battle, spellcast and combinations, water, air)
-	static std::shared_ptr<boost::multi_array<AIPathNode, 4>> shared;
-	std::shared_ptr<boost::multi_array<AIPathNode, 4>> nodes;
-public:
-	static boost::mutex locker;
-	static uint32_t version;
+	static constexpr size_t CHUNKS_PER_PAGE = 512;
+
+	struct TileChunks
+	{
+		uint32_t version = -1;
+		AIPathNode * buckets[AIPathfinding::BUCKET_COUNT] = {};
+	};
+
+	struct NodePool
+	{
+		// [z][x][y] - position on map, nodes of each bucket are located in pool pages
+		boost::multi_array<TileChunks, 3> tiles;
+		std::vector<std::unique_ptr<AIPathNode[]>> pages;
+		size_t usedChunks = 0;
+		uint32_t poolVersion = -1;
+		std::mutex allocationMutex;
 
+		NodePool(int3 sizes);
+	};
+
+	std::unique_ptr<NodePool> pool;
+	uint32_t version;
+
+	AIPathNode * allocateChunk(const int3 & tile);
+
+public:
 	AISharedStorage(int3 mapSize);
 	~AISharedStorage();
 
+	/// nodes of previous version become invalid, their chunks are reused
+	void nextVersion() { version++; }
+	uint32_t getVersion() const { return version; }
+	/// frees all pages, nodes of current version become invalid
+	void releasePages();
+
+	/// nodes of given bucket, nullptr if no node of the bucket was created in current version
 	STRONG_INLINE
-	boost::detail::multi_array::sub_array<AIPathNode, 1> get(int3 tile) const
+	AIPathNode * getBucket(const int3 & tile, int bucket) const
 	{
-		return (*nodes)[tile.z][tile.x][tile.y];
+		const TileChunks & chunks = pool->tiles[tile.z][tile.x][tile.y];
+
+		return chunks.version == version ? chunks.buckets[bucket] : nullptr;
+	}
+
+	AIPathNode * getOrCreateBucket(const int3 & tile, int bucket);
+
+	template<typename Fn>
+	bool iterateNodesUntil(const int3 & tile, Fn predicate) const
+	{
+		const TileChunks & chunks = pool->tiles[tile.z][tile.x][tile.y];
+
+		if(chunks.version != version)
+			return false;
+
+		for(AIPathNode * bucket : chunks.buckets)
+		{
+			if(!bucket)
+				continue;
+
+			for(int i = 0; i < AIPathfinding::BUCKET_SIZE; i++)
+			{
+				if(bucket[i].version == version && predicate(bucket[i]))
+					return true;
+			}
+		}
+
+		return false;
 	}
+
+	/// size of tile index and all allocated pages, pages are reused by next versions
+	size_t getAllocatedMemory() const;
+	/// size of nodes used by current version
+	size_t getUsedMemory() const;
 };
 
 class AINodeStorage : public INodeStorage
@@ -179,6 +240,8 @@ private:
 	AISharedStorage nodes;
 	std::vector<std::shared_ptr<ChainActor>> actors;
 	std::vector<CGPathNode *> heroChain;
+	mutable std::set<int3> committedTiles;
+	std::set<int3> committedTilesInitial;
 	EHeroChainPass heroChainPass; // true if we need to calculate hero chain
 	uint64_t chainMask;
 	int heroChainTurn;
@@ -281,6 +344,10 @@ public:
 		const std::set<const CGObjectInstance *> & visitableObjs);
 	const std::set<const CGHeroInstance *> getAllHeroes() const;
 	void clear();
+	/// frees memory of path nodes, paths have to be calculated again after it
+	void releaseMemory();
+	size_t getAllocatedMemory() const { return nodes.getAllocatedMemory() + accessibility->num_elements() * sizeof(EPathAccessibility); }
+	size_t getUsedMemory() const { return nodes.getUsedMemory(); }
 	bool calculateHeroChain();
 	bool calculateHeroChainFinal();
 
@@ -310,15 +377,13 @@ public:
 		if(blocked(pos, layer))
 			return;
 
-		auto chains = nodes.get(pos);
+		nodes.iterateNodesUntil(pos, [layer, &fn](AIPathNode & node) -> bool
+			{
+				if(node.layer == layer)
+					fn(node);
 
-		for(AIPathNode & node : chains)
-		{
-			if(node.version != AISharedStorage::version || node.layer != layer)
-				continue;
-
-			fn(node);
-		}
+				return false;
+			});
 	}
 
 	template<typename Fn>
@@ -327,18 +392,10 @@ public:
 		if(blocked(pos, layer))
 			return false;
 
-		auto chains = nodes.get(pos);
-
-		for(AIPathNode & node : chains)
-		{
-			if(node.version != AISharedStorage::version || node.layer != layer)
-				continue;
-
-			if(predicate(node))
-				return true;
-		}
-
-		return false;
+		return nodes.iterateNodesUntil(pos, [layer, &predicate](AIPathNode & node) -> bool
+			{
+				return node.layer == layer && predicate(node);
+			});
 	}
 
 
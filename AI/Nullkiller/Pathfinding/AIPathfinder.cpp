@@ -13,20 +13,36 @@
 #include "../../../CCallback.h"
 #include "../../../lib/mapping/CMap.h"
 #include "../Engine/Nullkiller.h"
+#include "../Engine/StateChangeTracker.h"
 
 namespace NKAI
 {
 
-std::map<ObjectInstanceID, std::unique_ptr<GraphPaths>>  AIPathfinder::heroGraphs;
-
 AIPathfinder::AIPathfinder(CPlayerSpecificInfoCallback * cb, Nullkiller * ai)
-	:cb(cb), ai(ai)
+	:cb(cb), ai(ai), heroLinksVersion(0)
 {
 }
 
 void AIPathfinder::init()
 {
 	storage.reset();
+	storedHeroes.clear();
+	heroGraphs.clear();
+	heroLinkTiles.clear();
+	heroLinksVersion++;
+}
+
+void AIPathfinder::releaseMemory()
+{
+	if(!storage)
+		return;
+
+	auto allocatedMemory = storage->getAllocatedMemory();
+
+	storedHeroes.clear();
+	storage->releaseMemory();
+
+	logAi->trace("Released path nodes, allocated memory %d KB -> %d KB", allocatedMemory / 1024, storage->getAllocatedMemory() / 1024);
 }
 
 bool AIPathfinder::isTileAccessible(const HeroPtr & hero, const int3 & tile) const
@@ -84,6 +100,8 @@ void AIPathfinder::updatePaths(const std::map<const CGHeroInstance *, HeroRole>
 	logAi->debug("Recalculate all paths");
 	int pass = 0;
 
+	// storage is invalid until calculation is complete, it may be interrupted
+	storedHeroes.clear();
 	storage->clear();
 	storage->setHeroes(heroes);
 	storage->setScoutTurnDistanceLimit(pathfinderSettings.scoutTurnDistanceLimit);
@@ -106,7 +124,10 @@ void AIPathfinder::updatePaths(const std::map<const CGHeroInstance *, HeroRole>
 
 	if(!pathfinderSettings.useHeroChain)
 	{
-		logAi->trace("Recalculated paths in %ld", timeElapsed(start));
+		storedHeroes = heroes;
+		storedSettings = pathfinderSettings;
+
+		logRecalculatedPaths(start);
 
 		return;
 	}
@@ -121,7 +142,8 @@ void AIPathfinder::updatePaths(const std::map<const CGHeroInstance *, HeroRole>
 
 			while(storage->calculateHeroChain())
 			{
-				boost::this_thread::interruption_point();
+				// hero chain passes take most of path calculation, other threads may apply game state changes between them
+				ai->finishStep();
 
 				logAi->trace("Recalculate paths pass %d", pass++);
 				cb->calculatePaths(config);
@@ -134,31 +156,118 @@ void AIPathfinder::updatePaths(const std::map<const CGHeroInstance *, HeroRole>
 
 		if(storage->calculateHeroChainFinal())
 		{
-			boost::this_thread::interruption_point();
+			ai->finishStep();
 
 			logAi->trace("Recalculate paths pass final");
 			cb->calculatePaths(config);
 		}
 	} while(storage->increaseHeroChainTurnLimit());
 
-	logAi->trace("Recalculated paths in %ld", timeElapsed(start));
+	storedHeroes = heroes;
+	storedSettings = pathfinderSettings;
+
+	logRecalculatedPaths(start);
+}
+
+void AIPathfinder::logRecalculatedPaths(std::chrono::time_point<std::chrono::high_resolution_clock> start) const
+{
+	logAi->debug(
+		"Recalculated paths of %s in %ld, path nodes use %d KB, %d KB allocated",
+		ai->playerID.toString(),
+		timeElapsed(start),
+		storage->getUsedMemory() / 1024,
+		storage->getAllocatedMemory() / 1024);
+}
+
+bool AIPathfinder::arePathsCalculated(const std::map<const CGHeroInstance *, HeroRole> & heroes, const PathfinderSettings & pathfinderSettings) const
+{
+	return storage && !storedHeroes.empty() && storedHeroes == heroes && storedSettings == pathfinderSettings;
+}
+
+bool AIPathfinder::updateHeroLinkTile(ObjectInstanceID heroID)
+{
+	auto obj = cb->getObj(heroID, false);
+
+	if(obj && obj->ID == Obj::HERO && vstd::contains(ai->memory->visitableObjs, obj))
+	{
+		auto tile = heroLinkTiles.find(heroID);
+
+		if(tile != heroLinkTiles.end() && tile->second == obj->visitablePos())
+			return false;
+
+		heroLinkTiles[heroID] = obj->visitablePos();
+
+		return true;
+	}
+
+	return heroLinkTiles.erase(heroID) > 0;
+}
+
+void AIPathfinder::updateHeroLinks(const StateChanges & changes, bool pathsUpdated)
+{
+	bool linksChanged = false;
+
+	if(changes.everything)
+	{
+		heroLinkTiles.clear();
+
+		for(auto obj : ai->memory->visitableObjs)
+		{
+			if(obj && obj->ID == Obj::HERO)
+				heroLinkTiles[obj->id] = obj->visitablePos();
+		}
+
+		linksChanged = true;
+	}
+	else
+	{
+		// heroes appear and disappear as objects, move as moved heroes, our heroes may also be lost
+		for(auto * ids : { &changes.movedHeroes, &changes.objects, &changes.heroes })
+		{
+			for(auto id : *ids)
+				linksChanged |= updateHeroLinkTile(id);
+		}
+	}
+
+	// links use paths of our heroes to each graph node, their cost and danger change together with paths
+	if(linksChanged || pathsUpdated)
+		heroLinksVersion++;
 }
 
 void AIPathfinder::updateGraphs(
 	const std::map<const CGHeroInstance *, HeroRole> & heroes,
 	uint8_t mainScanDepth,
 	uint8_t scoutScanDepth)
+{
+	updateGraphs(heroes, mainScanDepth, scoutScanDepth, std::set<ObjectInstanceID>());
+}
+
+void AIPathfinder::updateGraphs(
+	const std::map<const CGHeroInstance *, HeroRole> & heroes,
+	uint8_t mainScanDepth,
+	uint8_t scoutScanDepth,
+	const std::set<ObjectInstanceID> & changedHeroes)
 {
 	auto start = std::chrono::high_resolution_clock::now();
 	std::vector<const CGHeroInstance *> heroesVector;
+	std::shared_lock graphLock(Nullkiller::baseGraphMutex);
 
-	heroGraphs.clear();
+	vstd::erase_if(heroGraphs, [&](const std::pair<const ObjectInstanceID, std::unique_ptr<GraphPaths>> & graph) -> bool
+		{
+			return !vstd::contains_if(heroes, [&](const std::pair<const CGHeroInstance * const, HeroRole> & hero)
+				{
+					return hero.first->id == graph.first;
+				});
+		});
 
 	for(auto hero : heroes)
 	{
-		if(heroGraphs.try_emplace(hero.first->id).second)
+		auto scanLimit = hero.second == HeroRole::MAIN ? mainScanDepth : scoutScanDepth;
+		auto & graph = heroGraphs[hero.first->id];
+
+		if(!graph || vstd::contains(changedHeroes, hero.first->id) || !graph->isUpToDate(hero.first, ai, scanLimit))
 		{
-			heroGraphs[hero.first->id] = std::make_unique<GraphPaths>();
+			graph = std::make_unique<GraphPaths>();
 			heroesVector.push_back(hero.first);
 		}
 	}
@@ -182,7 +291,7 @@ void AIPathfinder::updateGraphs(
 		}
 	}
 
-	logAi->trace("Graph paths updated in %lld", timeElapsed(start));
+	logAi->trace("Graph paths updated for %d heroes in %lld", heroesVector.size(), timeElapsed(start));
 }
 
 }
@@ -19,6 +19,7 @@ namespace NKAI
 {
 
 class Nullkiller;
+struct StateChanges;
 
 struct PathfinderSettings
 {
@@ -33,6 +34,14 @@ struct PathfinderSettings
 		mainTurnDistanceLimit(255),
 		allowBypassObjects(true)
 	{ }
+
+	bool operator==(const PathfinderSettings & other) const
+	{
+		return useHeroChain == other.useHeroChain
+			&& scoutTurnDistanceLimit == other.scoutTurnDistanceLimit
+			&& mainTurnDistanceLimit == other.mainTurnDistanceLimit
+			&& allowBypassObjects == other.allowBypassObjects;
+	}
 };
 
 class AIPathfinder
@@ -41,16 +50,40 @@ private:
 	std::shared_ptr<AINodeStorage> storage;
 	CPlayerSpecificInfoCallback * cb;
 	Nullkiller * ai;
-	static std::map<ObjectInstanceID, std::unique_ptr<GraphPaths>>  heroGraphs;
+	// kept between turns, graph of a hero is recalculated only when it becomes outdated
+	std::map<ObjectInstanceID, std::unique_ptr<GraphPaths>> heroGraphs;
+
+	// actors and settings used for paths currently stored, empty if storage is not valid
+	std::map<const CGHeroInstance *, HeroRole> storedHeroes;
+	PathfinderSettings storedSettings;
+
+	// positions of heroes known to AI, graph paths link them to graph using regular paths
+	std::map<ObjectInstanceID, int3> heroLinkTiles;
+	// changes whenever links to heroes may have changed, so graph paths can detect that
+	uint32_t heroLinksVersion;
+
+	bool updateHeroLinkTile(ObjectInstanceID heroID);
+	void logRecalculatedPaths(std::chrono::time_point<std::chrono::high_resolution_clock> start) const;
 
 public:
 	AIPathfinder(CPlayerSpecificInfoCallback * cb, Nullkiller * ai);
 	void calculatePathInfo(std::vector<AIPath> & paths, const int3 & tile, bool includeGraph = false) const;
 	bool isTileAccessible(const HeroPtr & hero, const int3 & tile) const;
 	void updatePaths(const std::map<const CGHeroInstance *, HeroRole> & heroes, PathfinderSettings pathfinderSettings);
+	/// true if stored paths were calculated for same heroes and settings and can be reused while game state is unchanged
+	bool arePathsCalculated(const std::map<const CGHeroInstance *, HeroRole> & heroes, const PathfinderSettings & pathfinderSettings) const;
+	/// recalculates graph paths of heroes which moved, changed army, have no graph yet or whose links to other heroes changed, other graphs are kept between turns
 	void updateGraphs(const std::map<const CGHeroInstance *, HeroRole> & heroes, uint8_t mainScanDepth, uint8_t scoutScanDepth);
+	/// same as above but graph paths of given heroes are recalculated unconditionally
+	void updateGraphs(const std::map<const CGHeroInstance *, HeroRole> & heroes, uint8_t mainScanDepth, uint8_t scoutScanDepth, const std::set<ObjectInstanceID> & changedHeroes);
+	/// updates positions of heroes from reported changes, links also change whenever paths of our heroes were recalculated
+	void updateHeroLinks(const StateChanges & changes, bool pathsUpdated);
+	const std::map<ObjectInstanceID, int3> & getHeroLinkTiles() const { return heroLinkTiles; }
+	uint32_t getHeroLinksVersion() const { return heroLinksVersion; }
 	void calculateQuickPathsWithBlocker(std::vector<AIPath> & result, const std::vector<const CGHeroInstance *> & heroes, const int3 & tile);
 	void init();
+	/// frees path nodes between turns, graph paths are kept
+	void releaseMemory();
 
 	std::shared_ptr<AINodeStorage>getStorage()
 	{
@@ -53,8 +53,24 @@ std::shared_ptr<SpecialAction> getCompositeAction(
 	return std::make_shared<CompositeAction>(actionsArray);
 }
 
+GraphPathsKey::GraphPathsKey(const CGHeroInstance * hero, const Nullkiller * ai, uint8_t scanDepth)
+	:position(hero->visitablePos()),
+	movementPoints(hero->movementPointsRemaining()),
+	armyStrength(hero->getArmyStrength()),
+	scanDepth(scanDepth),
+	graphVersion(ai->baseGraph->getVersion()),
+	heroLinksVersion(ai->pathfinder->getHeroLinksVersion())
+{
+}
+
+bool GraphPaths::isUpToDate(const CGHeroInstance * targetHero, const Nullkiller * ai, uint8_t scanDepth) const
+{
+	return key == GraphPathsKey(targetHero, ai, scanDepth);
+}
+
 void GraphPaths::calculatePaths(const CGHeroInstance * targetHero, const Nullkiller * ai, uint8_t scanDepth)
 {
+	key = GraphPathsKey(targetHero, ai, scanDepth);
 	graph.copyFrom(*ai->baseGraph);
 	graph.connectHeroes(ai);
 
@@ -84,15 +84,42 @@ struct GraphPathNode
 	bool tryUpdate(const GraphPathNodePointer & pos, const GraphPathNode & prev, const ObjectLink & link);
 };
 
+/// Hero state graph paths were calculated for. Paths are reused between turns until any of it changes
+struct GraphPathsKey
+{
+	int3 position = int3(-1);
+	int movementPoints = -1;
+	uint64_t armyStrength = 0;
+	uint8_t scanDepth = 0;
+	uint32_t graphVersion = 0;
+	/// links to other heroes depend on their positions and on regular paths
+	uint32_t heroLinksVersion = 0;
+
+	GraphPathsKey() = default;
+	GraphPathsKey(const CGHeroInstance * hero, const Nullkiller * ai, uint8_t scanDepth);
+
+	bool operator==(const GraphPathsKey & other) const
+	{
+		return position == other.position
+			&& movementPoints == other.movementPoints
+			&& armyStrength == other.armyStrength
+			&& scanDepth == other.scanDepth
+			&& graphVersion == other.graphVersion
+			&& heroLinksVersion == other.heroLinksVersion;
+	}
+};
+
 class GraphPaths
 {
 	ObjectGraph graph;
 	GraphNodeStorage pathNodes;
 	std::string visualKey;
+	GraphPathsKey key;
 
 public:
 	GraphPaths();
 	void calculatePaths(const CGHeroInstance * targetHero, const Nullkiller * ai, uint8_t scanDepth);
+	bool isUpToDate(const CGHeroInstance * targetHero, const Nullkiller * ai, uint8_t scanDepth) const;
 	void addChainInfo(std::vector<AIPath> & paths, int3 tile, const CGHeroInstance * hero, const Nullkiller * ai) const;
 	void quickAddChainInfoWithBlocker(std::vector<AIPath> & paths, int3 tile, const CGHeroInstance * hero, const Nullkiller * ai) const;
 	void dumpToLog() const;
@@ -51,11 +51,19 @@ void ObjectGraph::updateGraph(const Nullkiller * ai)
 
 	ObjectGraphCalculator calculator(this, ai);
 
+	// graph is incomplete until calculation is finished, it may be interrupted
+	outdated = true;
+	version++;
+	nodes.clear();
+	virtualBoats.clear();
+
 	calculator.setGraphObjects();
 	calculator.calculateConnections();
 	calculator.addMinimalDistanceJunctions();
 	calculator.calculateConnections();
 
+	outdated = false;
+
 	if(NKAI_GRAPH_TRACE_LEVEL >= 1)
 		dumpToLog("graph");
 }
@@ -84,6 +92,7 @@ void ObjectGraph::registerJunction(const int3 & pos)
 void ObjectGraph::removeObject(const CGObjectInstance * obj)
 {
 	nodes[obj->visitablePos()].objectExists = false;
+	version++;
 
 	if(obj->ID == Obj::BOAT && !isVirtualBoat(obj->visitablePos()))
 	{
@@ -98,12 +107,12 @@ void ObjectGraph::removeObject(const CGObjectInstance * obj)
 
 void ObjectGraph::connectHeroes(const Nullkiller * ai)
 {
-	for(auto obj : ai->memory->visitableObjs)
+	for(auto & heroTile : ai->pathfinder->getHeroLinkTiles())
 	{
-		if(obj && obj->ID == Obj::HERO)
-		{
+		auto obj = ai->cb->getObj(heroTile.first, false);
+
+		if(obj)
 			addObject(obj);
-		}
 	}
 
 	for(auto & node : nodes)
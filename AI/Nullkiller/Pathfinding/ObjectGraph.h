@@ -64,10 +64,12 @@ class ObjectGraph
 {
 	std::unordered_map<int3, ObjectNode> nodes;
 	std::unordered_map<int3, ObjectInstanceID> virtualBoats;
+	uint32_t version;
+	bool outdated;
 
 public:
 	ObjectGraph()
-		:nodes(), virtualBoats()
+		:nodes(), virtualBoats(), version(0), outdated(true)
 	{
 	}
 
@@ -75,12 +77,20 @@ public:
 	void addObject(const CGObjectInstance * obj);
 	void registerJunction(const int3 & pos);
 	void addVirtualBoat(const int3 & pos, const CGObjectInstance * shipyard);
+	/// links heroes tracked by pathfinder to graph using their regular paths
 	void connectHeroes(const Nullkiller * ai);
 	void removeObject(const CGObjectInstance * obj);
 	bool tryAddConnection(const int3 & from, const int3 & to, float cost, uint64_t danger);
 	void removeConnection(const int3 & from, const int3 & to);
 	void dumpToLog(std::string visualKey) const;
 
+	/// graph is kept between turns, new objects are added only by full recalculation
+	void invalidate() { outdated = true; }
+	bool isOutdated() const { return outdated; }
+
+	/// changes every time nodes or connections are modified so graph paths built on top of it can detect that
+	uint32_t getVersion() const { return version; }
+
 	bool isVirtualBoat(const int3 & tile) const
 	{
 		return vstd::contains(virtualBoats, tile);
@@ -18,7 +18,7 @@ class EnemyInfo;
 class CStupidAI : public CBattleGameInterface
 {
 	BattleSide side;
-	std::shared_ptr<CBattleCallback> cb;
+	std::shared_ptr<IBattleCallback> cb;
 	std::shared_ptr<Environment> env;
 
 	bool wasWaitingForRealize;
@@ -29,8 +29,8 @@ public:
 	CStupidAI();
 	~CStupidAI();
 
-	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB) override;
-	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB, AutocombatPreferences autocombatPreferences) override;
+	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB) override;
+	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB, AutocombatPreferences autocombatPreferences) override;
 
 	void actionFinished(const BattleID & battleID, const BattleAction &action) override;//occurs AFTER every action taken by any stack or by the hero
 	void actionStarted(const BattleID & battleID, const BattleAction &action) override;//occurs BEFORE every action taken by any stack or by the hero
@@ -0,0 +1,301 @@
+/*
+ * BattleSimulator.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BattleSimulator.h"
+
+#include "BenchCallbacks.h"
+
+#include "../server/battles/BattleFlowProcessor.h"
+#include "../server/battles/BattleProcessor.h"
+#include "../server/battles/BattleResultProcessor.h"
+
+#include "../lib/CGameInterface.h"
+#include "../lib/CPlayerState.h"
+#include "../lib/CRandomGenerator.h"
+#include "../lib/StartInfo.h"
+#include "../lib/TerrainHandler.h"
+#include "../lib/VCMI_Lib.h"
+#include "../lib/battle/BattleAction.h"
+#include "../lib/battle/BattleInfo.h"
+#include "../lib/battle/BattleLayout.h"
+#include "../lib/gameState/CGameState.h"
+#include "../lib/mapObjects/CArmedInstance.h"
+#include "../lib/mapping/CMap.h"
+#include "../lib/networkPacks/PacksForClientBattle.h"
+#include "../lib/spells/CSpellHandler.h"
+#include "../lib/spells/ISpellMechanics.h"
+#include "../lib/spells/Problem.h"
+
+/// Battle processor for battles that are not bound to map objects, players or battle queries
+/// Battle ends as soon as its result is known - consequences of battle are not applied, since armies are reused by next battles
+class BenchBattleProcessor : public BattleProcessor
+{
+	std::optional<BattleSide> winner;
+
+protected:
+	void setBattleResult(const CBattleInfoCallback & battle, EBattleResult resultType, BattleSide victoriusSide) override
+	{
+		// registered result stops battle flow and rejects any further actions
+		resultProcessor->setBattleResult(battle, resultType, victoriusSide);
+		winner = victoriusSide;
+	}
+
+public:
+	using BattleProcessor::BattleProcessor;
+
+	/// Starts battle that was already applied to game state
+	void startPreparedBattle(const CBattleInfoCallback & battle)
+	{
+		flowProcessor->onBattleStarted(battle);
+	}
+
+	/// Returns winner of battle, or NONE in case of draw, once battle is over
+	std::optional<BattleSide> getWinner() const
+	{
+		return winner;
+	}
+};
+
+/// Checks whether action can be performed in current state of battle, same way as client does before sending action to server
+/// Server processes actions in several steps and may reject action only after some of its effects were already applied
+static bool isActionValid(const CBattleInfoCallback & battle, const BattleAction & ba)
+{
+	const CStack * stack = battle.battleGetStackByID(ba.stackNumber);
+
+	if(!stack || stack != battle.battleActiveUnit() || stack->unitSide() != ba.side)
+		return false;
+
+	battle::Target target = ba.getTarget(&battle);
+
+	auto canMoveTo = [&](BattleHex hex)
+	{
+		return hex == stack->getPosition() || vstd::contains(battle.battleGetAvailableHexes(stack, false), hex);
+	};
+
+	switch(ba.actionType)
+	{
+		case EActionType::WAIT:
+		case EActionType::DEFEND:
+			return true;
+		case EActionType::RETREAT:
+			return battle.battleCanFlee(battle.sideToPlayer(ba.side));
+		case EActionType::SURRENDER:
+			return battle.battleCanSurrender(battle.sideToPlayer(ba.side));
+		case EActionType::WALK:
+			return !target.empty() && target[0].hexValue != stack->getPosition() && canMoveTo(target[0].hexValue);
+		case EActionType::WALK_AND_ATTACK:
+		{
+			if(target.size() < 2 || !canMoveTo(target[0].hexValue))
+				return false;
+
+			const CStack * destinationStack = battle.battleGetStackByPos(target[1].hexValue, true);
+
+			if(!destinationStack || destinationStack == stack || !battle.battleCanAttack(stack, destinationStack, target[1].hexValue))
+				return false;
+
+			// double-wide unit may be moved to adjacent hex if it can not stand on specified one, same as in server
+			BattleHex shiftedPosition = target[0].hexValue.cloneInDirection(stack->destShiftDir(), false);
+
+			return CStack::isMeleeAttackPossible(stack, destinationStack, target[0].hexValue)
+				|| (stack->doubleWide() && CStack::isMeleeAttackPossible(stack, destinationStack, shiftedPosition));
+		}
+		case EActionType::SHOOT:
+			return !target.empty() && battle.battleGetStackByPos(target[0].hexValue) && battle.battleCanShoot(stack, target[0].hexValue);
+		case EActionType::MONSTER_SPELL:
+		{
+			// spell of random spellcaster is selected by server, only its target can be checked
+			if(stack->hasBonusOfType(BonusType::RANDOM_SPELLCASTER))
+				return target.size() == 1 && (target[0].unitValue || battle.battleGetStackByPos(target[0].hexValue, true));
+
+			auto spellcaster = stack->getBonus(Selector::typeSubtype(BonusType::SPELLCASTER, BonusSubtypeID(ba.spell)));
+			if(!spellcaster)
+				return false;
+
+			const CSpell * spell = ba.spell.toSpell();
+			spells::BattleCast parameters(&battle, stack, spells::Mode::CREATURE_ACTIVE, spell);
+			parameters.setSpellLevel(spellcaster->val);
+
+			spells::detail::ProblemImpl problem;
+			return spell->battleMechanics(&parameters)->canBeCastAt(target, problem);
+		}
+	}
+	// hero spells, tactics and war machine actions are not possible in battles without heroes
+	return false;
+}
+
+BattleSimulator::BattleSimulator(const BattleBenchScenario & scenario)
+	: CGameHandler(nullptr)
+	, scenario(scenario)
+{
+	gs = new CGameState();
+	gs->preInit(VLC, this);
+	// empty map only provides game settings to battle processors
+	gs->map = new CMap(this);
+	gs->scenarioOps = new StartInfo();
+	gs->scenarioOps->mode = EStartMode::NEW_GAME;
+	gs->scenarioOps->difficulty = scenario.difficulty;
+
+	environment = std::make_shared<BenchEnvironment>(gs);
+
+	if(this->scenario.battlefield == BattleField::NONE)
+	{
+		const auto & battlefields = this->scenario.terrain.toEntity(VLC)->battleFields;
+		if(battlefields.empty())
+			throw std::runtime_error("Terrain " + this->scenario.terrain.toEntity(VLC)->getJsonKey() + " has no battlefields!");
+		this->scenario.battlefield = battlefields.front();
+	}
+
+	for(auto side : { BattleSide::ATTACKER, BattleSide::DEFENDER })
+	{
+		const auto & sideConfig = scenario.sides[side];
+		PlayerColor color(static_cast<int>(side));
+
+		callbacks[side] = std::make_shared<BenchBattleCallback>(color);
+
+		// battle processors look up state of players that take part in battle, e.g. for turn timers
+		gs->players[color].color = color;
+
+		armies[side] = std::make_unique<CArmedInstance>(nullptr);
+		armies[side]->tempOwner = color;
+		armies[side]->setFormation(sideConfig.formation);
+
+		if(sideConfig.units.empty() || sideConfig.units.size() > GameConstants::ARMY_SIZE)
+			throw std::runtime_error("Each side must have from 1 to 7 units!");
+
+		for(size_t i = 0; i < sideConfig.units.size(); ++i)
+			armies[side]->putStack(SlotID(i), new CStackInstance(sideConfig.units[i].getId(), sideConfig.units[i].count));
+	}
+}
+
+BattleSimulator::~BattleSimulator()
+{
+	// battles must be removed while armies are still alive
+	gs->currentBattles.clear();
+}
+
+const BattleInfo & BattleSimulator::battle() const
+{
+	return *gs->currentBattles.front();
+}
+
+BattleID BattleSimulator::battleID() const
+{
+	return battle().getBattleID();
+}
+
+BattleSimulationResult BattleSimulator::run(int seed)
+{
+	result = BattleSimulationResult();
+	pendingUnit.reset();
+	processor = std::make_unique<BenchBattleProcessor>(this);
+	randomNumberGenerator->setSeed(seed);
+	// battle AI's use default generator of the thread that calls them, e.g. for spells of random spellcasters
+	CRandomGenerator::getDefault().setSeed(seed);
+
+	for(auto side : { BattleSide::ATTACKER, BattleSide::DEFENDER })
+	{
+		ais[side] = CDynLibHandler::getNewBattleAI(scenario.sides[side].aiName);
+		ais[side]->initBattleInterface(environment, callbacks[side]);
+	}
+
+	// battle tile is only used to seed placement of obstacles
+	int3 tile(seed, 0, 0);
+
+	BattleSideArray<const CArmedInstance *> armyObjects{armies[BattleSide::ATTACKER].get(), armies[BattleSide::DEFENDER].get()};
+	BattleSideArray<const CGHeroInstance *> heroes{nullptr, nullptr};
+	auto layout = BattleLayout::createLayout(*VLC->engineSettings(), "default", armyObjects[BattleSide::ATTACKER], armyObjects[BattleSide::DEFENDER]);
+
+	BattleStart bs;
+	bs.info = BattleInfo::setupBattle(tile, scenario.terrain, scenario.battlefield, armyObjects, heroes, layout, nullptr);
+	bs.battleID = gs->nextBattleID;
+	sendAndApply(&bs);
+
+	processor->startPreparedBattle(battle());
+
+	while(pendingUnit && !processor->getWinner() && result.rounds <= scenario.roundLimit)
+	{
+		const CStack * stack = battle().battleGetStackByID(*pendingUnit);
+		pendingUnit.reset();
+
+		auto side = stack->unitSide();
+		auto start = std::chrono::steady_clock::now();
+		ais[side]->activeStack(battleID(), stack);
+		auto finish = std::chrono::steady_clock::now();
+
+		result.decisionTimes[side].push_back(std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count());
+		result.actions += 1;
+
+		auto action = callbacks[side]->takeAction();
+
+		if(!action || !isActionValid(battle(), *action))
+		{
+			result.rejectedActions += 1;
+			action = BattleAction::makeDefend(stack);
+		}
+
+		if(!processor->makePlayerBattleAction(battleID(), battle().sideToPlayer(side), *action))
+			result.rejectedActions += 1;
+	}
+
+	result.winner = processor->getWinner().value_or(BattleSide::NONE);
+
+	BattleResult br;
+	br.battleID = battleID();
+	br.winner = result.winner;
+
+	for(auto side : { BattleSide::ATTACKER, BattleSide::DEFENDER })
+	{
+		ais[side]->battleEnd(battleID(), &br, QueryID::NONE);
+		callbacks[side]->onBattleEnded(battleID());
+		ais[side].reset();
+	}
+
+	gs->currentBattles.clear();
+	processor.reset();
+	return result;
+}
+
+void BattleSimulator::onBattleStarted(const BattleStart & pack)
+{
+	for(auto side : { BattleSide::ATTACKER, BattleSide::DEFENDER })
+	{
+		callbacks[side]->onBattleStarted(pack.info);
+		ais[side]->battleStart(pack.battleID, armies[BattleSide::ATTACKER].get(), armies[BattleSide::DEFENDER].get(), pack.info->getLocation(), nullptr, nullptr, side, false);
+	}
+}
+
+void BattleSimulator::onNextRound()
+{
+	result.rounds += 1;
+
+	for(const auto & ai : ais)
+		ai->battleNewRound(battleID());
+}
+
+void BattleSimulator::sendAndApply(CPackForClient * pack)
+{
+	gs->apply(pack);
+
+	// notify AI's about the same events on which client calls battle interfaces
+	if(auto * battleStart = dynamic_cast<BattleStart *>(pack))
+		onBattleStarted(*battleStart);
+
+	if(dynamic_cast<BattleNextRound *>(pack))
+		onNextRound();
+
+	// actual activeStack call is made by run() - AI may not make its action while server is still processing previous one
+	if(auto * activeStack = dynamic_cast<BattleSetActiveStack *>(pack); activeStack && activeStack->askPlayerInterface)
+		pendingUnit = activeStack->stack;
+}
+
+void BattleSimulator::sendToAllClients(CPackForClient * pack)
+{
+	// there are no clients - packs that are applied to game state are delivered by sendAndApply, everything else is discarded
+}
@@ -0,0 +1,85 @@
+/*
+ * BattleSimulator.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/CStack.h"
+#include "../lib/battle/BattleSide.h"
+#include "../server/CGameHandler.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+class BattleInfo;
+class CArmedInstance;
+class CBattleGameInterface;
+struct BattleStart;
+VCMI_LIB_NAMESPACE_END
+
+class BenchBattleCallback;
+class BenchBattleProcessor;
+class BenchEnvironment;
+
+struct BattleBenchSide
+{
+	std::string aiName;
+	EArmyFormation formation = EArmyFormation::LOOSE;
+	std::vector<CStackBasicDescriptor> units;
+};
+
+/// Description of a single battle setup, shared by all battles of a benchmark run
+struct BattleBenchScenario
+{
+	BattleSideArray<BattleBenchSide> sides;
+	TerrainId terrain = ETerrainId::GRASS;
+	BattleField battlefield = BattleField(0);
+	ui8 difficulty = 1;
+	int roundLimit = 100;
+};
+
+struct BattleSimulationResult
+{
+	BattleSide winner = BattleSide::NONE; // NONE if battle was interrupted by round limit
+	int rounds = 0;
+	int actions = 0;
+	int rejectedActions = 0;
+	/// time spent by AI in activeStack call, in microseconds
+	BattleSideArray<std::vector<uint64_t>> decisionTimes;
+};
+
+/// Runs battles between two battle AI's without server or client
+/// Acts as game handler for server-side battle processors: packs are applied to game state and delivered directly to AI's instead of network
+class BattleSimulator : public CGameHandler
+{
+	BattleBenchScenario scenario;
+	std::shared_ptr<BenchEnvironment> environment;
+	std::unique_ptr<BenchBattleProcessor> processor;
+	BattleSideArray<std::shared_ptr<BenchBattleCallback>> callbacks;
+	BattleSideArray<std::shared_ptr<CBattleGameInterface>> ais;
+	BattleSideArray<std::unique_ptr<CArmedInstance>> armies;
+
+	BattleSimulationResult result;
+	/// unit that waits for decision of its AI, if any
+	std::optional<uint32_t> pendingUnit;
+
+	const BattleInfo & battle() const;
+	BattleID battleID() const;
+
+	void onBattleStarted(const BattleStart & pack);
+	void onNextRound();
+
+public:
+	explicit BattleSimulator(const BattleBenchScenario & scenario);
+	~BattleSimulator();
+
+	/// Plays single battle to the end. Result depends only on scenario and seed
+	BattleSimulationResult run(int seed);
+
+	using CGameHandler::sendAndApply;
+	void sendAndApply(CPackForClient * pack) override;
+	void sendToAllClients(CPackForClient * pack) override;
+};
@@ -0,0 +1,108 @@
+/*
+ * BenchCallbacks.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BenchCallbacks.h"
+
+#include "../lib/VCMI_Lib.h"
+#include "../lib/battle/BattleInfo.h"
+#include "../lib/battle/CPlayerBattleCallback.h"
+#include "../lib/gameState/CGameState.h"
+
+#include <vcmi/events/EventBus.h>
+
+BenchBattleCallback::BenchBattleCallback(PlayerColor player)
+	: player(player)
+{
+}
+
+void BenchBattleCallback::battleMakeSpellAction(const BattleID & battleID, const BattleAction & action)
+{
+	pendingAction = action;
+}
+
+void BenchBattleCallback::battleMakeUnitAction(const BattleID & battleID, const BattleAction & action)
+{
+	pendingAction = action;
+}
+
+void BenchBattleCallback::battleMakeTacticAction(const BattleID & battleID, const BattleAction & action)
+{
+	// armies in benchmark have no heroes, so tactics phase never happens
+	logGlobal->warn("Unexpected tactic action from %s: %s", player.toString(), action.toString());
+}
+
+std::optional<BattleAction> BenchBattleCallback::makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState)
+{
+	return std::nullopt;
+}
+
+std::shared_ptr<CPlayerBattleCallback> BenchBattleCallback::getBattle(const BattleID & battleID)
+{
+	if (activeBattles.count(battleID))
+		return activeBattles.at(battleID);
+
+	throw std::runtime_error("Failed to find battle " + std::to_string(battleID.getNum()) + " of player " + player.toString());
+}
+
+std::optional<PlayerColor> BenchBattleCallback::getPlayerID() const
+{
+	return player;
+}
+
+void BenchBattleCallback::onBattleStarted(const IBattleInfo * info)
+{
+	activeBattles[info->getBattleID()] = std::make_shared<CPlayerBattleCallback>(info, player);
+}
+
+void BenchBattleCallback::onBattleEnded(const BattleID & battleID)
+{
+	activeBattles.erase(battleID);
+	pendingAction.reset();
+}
+
+std::optional<BattleAction> BenchBattleCallback::takeAction()
+{
+	auto result = pendingAction;
+	pendingAction.reset();
+	return result;
+}
+
+BenchEnvironment::BenchEnvironment(const CGameState * gameState)
+	: gameState(gameState)
+	, bus(std::make_unique<events::EventBus>())
+{
+}
+
+BenchEnvironment::~BenchEnvironment() = default;
+
+const Services * BenchEnvironment::services() const
+{
+	return VLC;
+}
+
+const Environment::BattleCb * BenchEnvironment::battle(const BattleID & battleID) const
+{
+	return gameState->getBattle(battleID);
+}
+
+const Environment::GameCb * BenchEnvironment::game() const
+{
+	return gameState;
+}
+
+vstd::CLoggerBase * BenchEnvironment::logger() const
+{
+	return logGlobal;
+}
+
+events::EventBus * BenchEnvironment::eventBus() const
+{
+	return bus.get();
+}
@@ -0,0 +1,63 @@
+/*
+ * BenchCallbacks.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../CCallback.h"
+#include "../lib/battle/BattleAction.h"
+
+#include <vcmi/Environment.h>
+
+VCMI_LIB_NAMESPACE_BEGIN
+class CGameState;
+class IBattleInfo;
+VCMI_LIB_NAMESPACE_END
+
+/// Battle callback given to battle AI in place of network-backed CBattleCallback
+/// Instead of sending requests to server, it stores action selected by AI until simulator picks it up
+class BenchBattleCallback : public IBattleCallback
+{
+	std::map<BattleID, std::shared_ptr<CPlayerBattleCallback>> activeBattles;
+	std::optional<BattleAction> pendingAction;
+	PlayerColor player;
+
+public:
+	explicit BenchBattleCallback(PlayerColor player);
+
+	void battleMakeSpellAction(const BattleID & battleID, const BattleAction & action) override;
+	void battleMakeUnitAction(const BattleID & battleID, const BattleAction & action) override;
+	void battleMakeTacticAction(const BattleID & battleID, const BattleAction & action) override;
+	std::optional<BattleAction> makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState) override;
+
+	std::shared_ptr<CPlayerBattleCallback> getBattle(const BattleID & battleID) override;
+	std::optional<PlayerColor> getPlayerID() const override;
+
+	void onBattleStarted(const IBattleInfo * info);
+	void onBattleEnded(const BattleID & battleID);
+
+	/// Returns action made by AI since last call, if any
+	std::optional<BattleAction> takeAction();
+};
+
+/// Environment for battle AI that exposes game state owned by simulator
+class BenchEnvironment : public Environment
+{
+	const CGameState * gameState;
+	std::unique_ptr<events::EventBus> bus;
+
+public:
+	explicit BenchEnvironment(const CGameState * gameState);
+	~BenchEnvironment();
+
+	const Services * services() const override;
+	const BattleCb * battle(const BattleID & battleID) const override;
+	const GameCb * game() const override;
+	vstd::CLoggerBase * logger() const override;
+	events::EventBus * eventBus() const override;
+};
@@ -0,0 +1,247 @@
+/*
+ * EntryPoint.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "BattleSimulator.h"
+
+#include "../lib/CConsoleHandler.h"
+#include "../lib/VCMIDirs.h"
+#include "../lib/VCMI_Lib.h"
+#include "../lib/json/JsonNode.h"
+#include "../lib/logging/CBasicLogConfigurator.h"
+#include "../lib/modding/CModHandler.h"
+#include "../lib/modding/IdentifierStorage.h"
+#include "../lib/modding/ModScope.h"
+
+#include <boost/program_options.hpp>
+
+static void handleCommandOptions(int argc, const char * argv[], boost::program_options::variables_map & options)
+{
+	boost::program_options::options_description opts("Allowed options");
+	opts.add_options()
+	("help,h", "display help and exit")
+	("version,v", "display version information and exit")
+	("scenario", boost::program_options::value<std::string>(), "path to json file with description of battle to simulate")
+	("battles", boost::program_options::value<int>()->default_value(100), "number of battles to simulate")
+	("seed", boost::program_options::value<int>()->default_value(0), "seed of first battle, each next battle uses next seed")
+	("attacker-ai", boost::program_options::value<std::string>(), "battle AI of attacker, overrides value from scenario")
+	("defender-ai", boost::program_options::value<std::string>(), "battle AI of defender, overrides value from scenario")
+	("startup-only", "only load game data, report loading time and exit")
+	("clear-mod-cache", "remove cached mod data before loading to measure cold startup");
+
+	try
+	{
+		boost::program_options::store(boost::program_options::parse_command_line(argc, argv, opts), options);
+	}
+	catch(boost::program_options::error & e)
+	{
+		std::cerr << "Failure during parsing command-line options:\n" << e.what() << std::endl;
+		std::cerr << "Use --help to see list of allowed options" << std::endl;
+		exit(1);
+	}
+
+	boost::program_options::notify(options);
+
+	if(options.count("help") || (!options.count("scenario") && !options.count("startup-only")))
+	{
+		printf("%s - headless battle AI benchmark\n", GameConstants::VCMI_VERSION.c_str());
+		printf("Usage: vcmibattlebench --scenario <file.json> [--battles N] [--seed S]\n");
+		printf("       vcmibattlebench --startup-only [--clear-mod-cache]\n");
+		printf("\n");
+		std::cout << opts;
+		exit(0);
+	}
+
+	if(options.count("version"))
+	{
+		printf("%s\n", GameConstants::VCMI_VERSION.c_str());
+		std::cout << VCMIDirs::get().genHelpString();
+		exit(0);
+	}
+}
+
+static si32 resolveIdentifier(const std::string & type, const std::string & name)
+{
+	auto id = VLC->identifiers()->getIdentifier(ModScope::scopeGame(), type, name);
+	if(!id)
+		throw std::runtime_error("Unknown " + type + ": " + name);
+	return *id;
+}
+
+static BattleBenchSide loadSide(const JsonNode & config, const std::string & aiOverride)
+{
+	BattleBenchSide result;
+
+	result.aiName = aiOverride.empty() ? config["ai"].String() : aiOverride;
+	if(result.aiName.empty())
+		result.aiName = "BattleAI";
+
+	if(config["formation"].String() == "tight")
+		result.formation = EArmyFormation::TIGHT;
+
+	for(const auto & unit : config["units"].Vector())
+	{
+		CreatureID creature(resolveIdentifier("creature", unit["type"].String()));
+		result.units.emplace_back(creature, unit["amount"].Integer());
+	}
+	return result;
+}
+
+static BattleBenchScenario loadScenario(const boost::filesystem::path & path, const boost::program_options::variables_map & opts)
+{
+	boost::filesystem::ifstream file(path, std::ios::binary);
+	if(!file)
+		throw std::runtime_error("Failed to open scenario file " + path.string());
+
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	JsonNode config(reinterpret_cast<const std::byte *>(data.data()), data.size(), path.string());
+
+	BattleBenchScenario result;
+
+	auto aiOverride = [&](const std::string & option)
+	{
+		return opts.count(option) ? opts[option].as<std::string>() : std::string();
+	};
+
+	result.sides[BattleSide::ATTACKER] = loadSide(config["attacker"], aiOverride("attacker-ai"));
+	result.sides[BattleSide::DEFENDER] = loadSide(config["defender"], aiOverride("defender-ai"));
+
+	if(!config["terrain"].isNull())
+		result.terrain = TerrainId(resolveIdentifier("terrain", config["terrain"].String()));
+	if(!config["battlefield"].isNull())
+		result.battlefield = BattleField(resolveIdentifier("battlefield", config["battlefield"].String()));
+	if(!config["difficulty"].isNull())
+		result.difficulty = config["difficulty"].Integer();
+	if(!config["roundLimit"].isNull())
+		result.roundLimit = config["roundLimit"].Integer();
+
+	return result;
+}
+
+static uint64_t percentile(const std::vector<uint64_t> & sortedValues, double fraction)
+{
+	if(sortedValues.empty())
+		return 0;
+
+	size_t index = static_cast<size_t>(fraction * (sortedValues.size() - 1) + 0.5);
+	return sortedValues[index];
+}
+
+static void printReport(const BattleBenchScenario & scenario, const std::vector<BattleSimulationResult> & results, double totalSeconds)
+{
+	BattleSideArray<std::vector<uint64_t>> decisionTimes;
+	std::map<BattleSide, int> wins;
+	int64_t totalRounds = 0;
+	int64_t totalActions = 0;
+	int64_t totalRejected = 0;
+
+	for(const auto & result : results)
+	{
+		wins[result.winner] += 1;
+		totalRounds += result.rounds;
+		totalActions += result.actions;
+		totalRejected += result.rejectedActions;
+
+		for(auto side : { BattleSide::ATTACKER, BattleSide::DEFENDER })
+			vstd::concatenate(decisionTimes[side], result.decisionTimes[side]);
+	}
+
+	double battles = results.size();
+
+	printf("Battles simulated: %d in %.3f s (%.2f battles/s)\n", static_cast<int>(results.size()), totalSeconds, battles / totalSeconds);
+	printf("Average rounds: %.2f, average actions: %.2f, rejected actions: %d\n", totalRounds / battles, totalActions / battles, static_cast<int>(totalRejected));
+	printf("Attacker wins: %5.1f%%\n", 100.0 * wins[BattleSide::ATTACKER] / battles);
+	printf("Defender wins: %5.1f%%\n", 100.0 * wins[BattleSide::DEFENDER] / battles);
+	printf("Draws:         %5.1f%%\n", 100.0 * wins[BattleSide::NONE] / battles);
+	printf("\n");
+	printf("Decision latency, microseconds:\n");
+	printf("%-10s %-12s %10s %10s %10s %10s %10s\n", "side", "ai", "decisions", "p50", "p90", "p99", "max");
+
+	for(auto side : { BattleSide::ATTACKER, BattleSide::DEFENDER })
+	{
+		auto & times = decisionTimes[side];
+		std::sort(times.begin(), times.end());
+
+		printf("%-10s %-12s %10d %10llu %10llu %10llu %10llu\n",
+			side == BattleSide::ATTACKER ? "attacker" : "defender",
+			scenario.sides[side].aiName.c_str(),
+			static_cast<int>(times.size()),
+			static_cast<unsigned long long>(percentile(times, 0.5)),
+			static_cast<unsigned long long>(percentile(times, 0.9)),
+			static_cast<unsigned long long>(percentile(times, 0.99)),
+			static_cast<unsigned long long>(times.empty() ? 0 : times.back()));
+	}
+}
+
+static int runBattles(const boost::program_options::variables_map & opts, const boost::filesystem::path & workingDir)
+{
+	try
+	{
+		auto scenario = loadScenario(boost::filesystem::absolute(opts["scenario"].as<std::string>(), workingDir), opts);
+		int battles = opts["battles"].as<int>();
+		int seed = opts["seed"].as<int>();
+
+		if(battles <= 0)
+			throw std::runtime_error("Number of battles must be positive!");
+
+		BattleSimulator simulator(scenario);
+		std::vector<BattleSimulationResult> results;
+		results.reserve(battles);
+
+		auto start = std::chrono::steady_clock::now();
+		for(int i = 0; i < battles; ++i)
+			results.push_back(simulator.run(seed + i));
+		auto finish = std::chrono::steady_clock::now();
+
+		printReport(scenario, results, std::chrono::duration<double>(finish - start).count());
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->error("Battle benchmark failed: %s", e.what());
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, const char * argv[])
+{
+	// scenario path is relative to directory in which benchmark was started
+	auto workingDir = boost::filesystem::current_path();
+
+	// Correct working dir executable folder (not bundle folder) so we can use executable relative paths
+	boost::filesystem::current_path(boost::filesystem::system_complete(argv[0]).parent_path());
+
+	console = new CConsoleHandler();
+	CBasicLogConfigurator logConfig(VCMIDirs::get().userLogsPath() / "VCMI_BattleBench_log.txt", console);
+	logConfig.configureDefault();
+
+	boost::program_options::variables_map opts;
+	handleCommandOptions(argc, argv, opts);
+	preinitDLL(console, false);
+	logConfig.configure();
+
+	if(opts.count("clear-mod-cache"))
+		boost::filesystem::remove(CModHandler::getContentCachePath());
+
+	auto loadStart = std::chrono::steady_clock::now();
+	loadDLLClasses();
+	auto loadFinish = std::chrono::steady_clock::now();
+
+	printf("Game data loaded in %d ms\n", static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(loadFinish - loadStart).count()));
+
+	int result = 0;
+	if(!opts.count("startup-only"))
+		result = runBattles(opts, workingDir);
+
+	logConfig.deconfigure();
+	vstd::clear_pointer(VLC);
+
+	return result;
+}
@@ -0,0 +1,40 @@
+/*
+ * ClientBenchmarks.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "ClientBenchmarks.h"
+
+#include "benchmarks/BlitBenchmark.h"
+#include "benchmarks/DefBenchmark.h"
+#include "benchmarks/JsonBenchmark.h"
+#include "benchmarks/PaletteBenchmark.h"
+
+static const std::map<std::string, std::function<std::string()>> benchmarks = {
+	{ "json", ClientBenchmarks::runJsonBenchmark },
+	{ "defs", ClientBenchmarks::runDefBenchmark },
+	{ "blit", ClientBenchmarks::runBlitBenchmark },
+	{ "palette", ClientBenchmarks::runPaletteBenchmark },
+};
+
+std::vector<std::string> ClientBenchmarks::getNames()
+{
+	std::vector<std::string> result;
+	for(const auto & entry : benchmarks)
+		result.push_back(entry.first);
+	return result;
+}
+
+std::string ClientBenchmarks::run(const std::string & name)
+{
+	auto it = benchmarks.find(name);
+	if(it == benchmarks.end())
+		return std::string();
+
+	return it->second();
+}
@@ -0,0 +1,21 @@
+/*
+ * ClientBenchmarks.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+/// Developer benchmarks that can be started from client console using "benchmark <name>" command
+namespace ClientBenchmarks
+{
+	/// returns names of all available benchmarks
+	std::vector<std::string> getNames();
+
+	/// runs benchmark with specified name and returns its report
+	/// returns empty string if there is no benchmark with such name
+	std::string run(const std::string & name);
+}
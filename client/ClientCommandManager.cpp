@@ -11,14 +11,17 @@
 #include "ClientCommandManager.h"
 
 #include "Client.h"
+#include "ClientBenchmarks.h"
 #include "adventureMap/CInGameConsole.h"
 #include "CPlayerInterface.h"
 #include "PlayerLocalState.h"
 #include "CServerHandler.h"
 #include "gui/CGuiHandler.h"
+#include "gui/FrameProfiler.h"
 #include "gui/WindowHandler.h"
 #include "render/IRenderHandler.h"
 #include "render/AssetGenerator.h"
+#include "renderSDL/CTrueTypeFont.h"
 #include "ClientNetPackVisitors.h"
 #include "../lib/CConfigHandler.h"
 #include "../lib/gameState/CGameState.h"
@@ -30,6 +33,7 @@
 #include "windows/CCastleInterface.h"
 #include "../lib/mapObjects/CGHeroInstance.h"
 #include "render/CAnimation.h"
+#include "render/Graphics.h"
 #include "../CCallback.h"
 #include "../lib/texts/CGeneralTextHandler.h"
 #include "../lib/filesystem/Filesystem.h"
@@ -508,6 +512,64 @@ void ClientCommandManager::handleGenerateAssets()
 	printCommandMessage("All assets generated");
 }
 
+void ClientCommandManager::handleBenchmarkCommand(std::istringstream & singleWordBuffer)
+{
+	std::string name;
+	singleWordBuffer >> name;
+
+	printCommandMessage("Command accepted.\t");
+
+	std::string report = ClientBenchmarks::run(name);
+	if(report.empty())
+		printCommandMessage("Unknown benchmark! Available benchmarks: " + boost::algorithm::join(ClientBenchmarks::getNames(), ", ") + "\n", ELogLevel::ERROR);
+	else
+		printCommandMessage(report);
+}
+
+void ClientCommandManager::handleFrameTraceStartCommand()
+{
+	auto path = VCMIDirs::get().userLogsPath() / "VCMI_Client_frame_trace.json";
+
+	if(GH.profiler().startTrace(path))
+		printCommandMessage("Writing frame trace to " + path.string() + "\n");
+	else
+		printCommandMessage("Failed to open " + path.string() + "\n", ELogLevel::ERROR);
+}
+
+void ClientCommandManager::handleFrameTraceStopCommand()
+{
+	if(!GH.profiler().isTraceActive())
+	{
+		printCommandMessage("Frame trace is not being written\n");
+		return;
+	}
+
+	GH.profiler().stopTrace();
+	printCommandMessage("Frame trace was written to " + GH.profiler().getTracePath().string() + "\n");
+}
+
+void ClientCommandManager::handleFontCacheCommand()
+{
+	printCommandMessage("Command accepted.\t");
+
+	bool anyFound = false;
+	for(size_t i = 0; i < graphics->fonts.size(); ++i)
+	{
+		const auto * font = dynamic_cast<const CTrueTypeFont *>(graphics->fonts[i].get());
+		if(!font)
+			continue;
+
+		auto stats = font->getCacheStatistics();
+		double hitRate = stats.hits + stats.misses == 0 ? 0 : 100.0 * stats.hits / (stats.hits + stats.misses);
+
+		printCommandMessage(boost::str(boost::format("Font %d: %d hits, %d misses, %.1f%% hit rate, %d texts in cache, %d KB\n") % i % stats.hits % stats.misses % hitRate % stats.entries % (stats.bytes / 1024)));
+		anyFound = true;
+	}
+
+	if(!anyFound)
+		printCommandMessage("No true type fonts are in use\n");
+}
+
 void ClientCommandManager::printCommandMessage(const std::string &commandMessage, ELogLevel::ELogLevel messageType)
 {
 	switch(messageType)
@@ -633,6 +695,18 @@ void ClientCommandManager::processCommand(const std::string & message, bool call
 	else if(message=="generate assets")
 		handleGenerateAssets();
 
+	else if(commandName == "benchmark")
+		handleBenchmarkCommand(singleWordBuffer);
+
+	else if(message=="frame trace start")
+		handleFrameTraceStartCommand();
+
+	else if(message=="frame trace stop")
+		handleFrameTraceStopCommand();
+
+	else if(message=="font cache")
+		handleFontCacheCommand();
+
 	else
 	{
 		if (!commandName.empty() && !vstd::iswithin(commandName[0], 0, ' ')) // filter-out debugger/IDE noise
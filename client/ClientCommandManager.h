@@ -87,6 +87,18 @@ class ClientCommandManager //take mantis #2292 issue about account if thinking a
 	// generate all assets
 	void handleGenerateAssets();
 
+	// runs one of developer benchmarks and prints its results
+	void handleBenchmarkCommand(std::istringstream & singleWordBuffer);
+
+	// starts writing durations of main loop and rendering steps to file in Chrome trace format
+	void handleFrameTraceStartCommand();
+
+	// finishes writing of frame trace file
+	void handleFrameTraceStopCommand();
+
+	// prints usage statistics of rendered text cache of all true type fonts
+	void handleFontCacheCommand();
+
 	// Prints in Chat the given message
 	void printCommandMessage(const std::string &commandMessage, ELogLevel::ELogLevel messageType = ELogLevel::NOT_SET);
 	void giveTurn(const PlayerColor &color);
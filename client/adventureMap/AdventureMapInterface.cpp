@@ -27,6 +27,7 @@
 #include "../widgets/RadialMenu.h"
 #include "../CGameInfo.h"
 #include "../gui/CursorHandler.h"
+#include "../gui/FrameProfiler.h"
 #include "../gui/CGuiHandler.h"
 #include "../gui/Shortcut.h"
 #include "../gui/WindowHandler.h"
@@ -166,6 +167,7 @@ void AdventureMapInterface::showAll(Canvas & to)
 
 void AdventureMapInterface::show(Canvas & to)
 {
+	FrameProfilerScope scope("adventure map");
 	CIntObject::show(to);
 	dim(to);
 	LOCPLINT->cingconsole->show(to);
@@ -199,6 +201,7 @@ void AdventureMapInterface::dim(Canvas & to)
 
 void AdventureMapInterface::tick(uint32_t msPassed)
 {
+	FrameProfilerScope scope("adventure map tick");
 	handleMapScrollingUpdate(msPassed);
 
 	// we want animations to be active during enemy turn but map itself to be non-interactive
@@ -455,6 +458,7 @@ void AdventureMapInterface::onPlayerTurnStarted(PlayerColor playerID)
 	onHeroChanged(nullptr);
 	Canvas canvas = Canvas::createFromSurface(screen, CanvasScalingPolicy::AUTO);
 	showAll(canvas);
+	GH.screenHandler().markDirty(pos);
 	mapAudio->onPlayerTurnStarted();
 
 	if(settings["session"]["autoSkip"].Bool() && !GH.isKeyboardShiftDown())
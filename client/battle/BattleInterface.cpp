@@ -61,6 +61,8 @@ BattleInterface::BattleInterface(const BattleID & battleID, const CCreatureSet *
 	, battleOpeningDelayActive(true)
 	, round(0)
 {
+	auto openingStart = std::chrono::steady_clock::now();
+
 	if(spectatorInt)
 	{
 		curInt = spectatorInt;
@@ -102,6 +104,9 @@ BattleInterface::BattleInterface(const BattleID & battleID, const CCreatureSet *
 	windowObject->blockUI(true);
 	windowObject->updateQueue();
 
+	auto openingTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - openingStart);
+	logGlobal->debug("Battle screen opened in %d ms", openingTime.count());
+
 	playIntroSoundAndUnlockInterface();
 }
 
@@ -19,6 +19,8 @@
 #include "BattleObstacleController.h"
 #include "BattleOverlayLogVisualizer.h"
 
+#include "../gui/FrameProfiler.h"
+
 void BattleRenderer::collectObjects()
 {
 	owner.effectsController->collectRenderableObjects(*this);
@@ -71,6 +73,8 @@ void BattleRenderer::insert(EBattleFieldLayer layer, BattleHex tile, BattleRende
 
 void BattleRenderer::execute(BattleRenderer::RendererRef targetCanvas)
 {
+	FrameProfilerScope scope("battle render");
+
 	collectObjects();
 	sortObjects();
 	renderObjects(targetCanvas);
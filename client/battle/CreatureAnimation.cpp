@@ -246,6 +246,9 @@ CreatureAnimation::CreatureAnimation(const AnimationPath & name_, TSpeedControll
 
 	reverse->verticalFlip();
 
+	forward->createAtlas();
+	reverse->createAtlas();
+
 	speed = speedController(this, type);
 }
 
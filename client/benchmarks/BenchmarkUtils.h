@@ -0,0 +1,53 @@
+/*
+ * BenchmarkUtils.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include <SDL_pixels.h>
+
+namespace ClientBenchmarks
+{
+	/// returns duration of fastest of several runs of function, in milliseconds
+	template<typename Function>
+	double measureBestTime(int iterations, const Function & function)
+	{
+		int64_t bestTime = std::numeric_limits<int64_t>::max();
+
+		for(int i = 0; i < iterations; ++i)
+		{
+			auto start = std::chrono::steady_clock::now();
+			function(i);
+			auto finish = std::chrono::steady_clock::now();
+
+			bestTime = std::min<int64_t>(bestTime, std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count());
+		}
+		return bestTime / 1000.0;
+	}
+
+	/// returns average duration of one run of function, in milliseconds
+	template<typename Function>
+	double measureAverageTime(int iterations, const Function & function)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for(int i = 0; i < iterations; ++i)
+			function(i);
+		auto finish = std::chrono::steady_clock::now();
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count() / 1000.0 / iterations;
+	}
+
+	/// palette with distinct opaque colors, similar to palettes of adventure map images
+	inline std::array<SDL_Color, 256> createTestPalette()
+	{
+		std::array<SDL_Color, 256> palette;
+		for(int i = 0; i < 256; ++i)
+			palette[i] = { static_cast<uint8_t>(i), static_cast<uint8_t>(255 - i), static_cast<uint8_t>(i * 7), SDL_ALPHA_OPAQUE };
+		return palette;
+	}
+}
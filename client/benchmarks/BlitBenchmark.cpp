@@ -0,0 +1,93 @@
+/*
+ * BlitBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BlitBenchmark.h"
+
+#include "BenchmarkUtils.h"
+
+#include "../gui/CGuiHandler.h"
+#include "../renderSDL/SDL_Extensions.h"
+
+#include <SDL_surface.h>
+
+std::string ClientBenchmarks::runBlitBenchmark()
+{
+	// Uses only offscreen surfaces, so it can also be run with SDL_VIDEODRIVER=dummy
+	constexpr int tileSize = 32;
+	const Point frameSize = GH.screenDimensions();
+
+	// palette layout of adventure map def's: transparency and shadow in first entries, followed by opaque colors
+	auto palette = createTestPalette();
+	palette[0] = { 0, 0, 0, SDL_ALPHA_TRANSPARENT };
+	palette[1] = { 0, 0, 0, 64 };
+	palette[4] = { 0, 0, 0, 128 };
+
+	auto createSprite = [&palette](int width, int height, bool withTransparency)
+	{
+		SDL_Surface * sprite = SDL_CreateRGBSurface(0, width, height, 8, 0, 0, 0, 0);
+		SDL_SetPaletteColors(sprite->format->palette, palette.data(), 0, 256);
+
+		for(int y = 0; y < height; ++y)
+		{
+			auto * row = static_cast<uint8_t *>(sprite->pixels) + y * sprite->pitch;
+			for(int x = 0; x < width; ++x)
+			{
+				// object occupies center of its sprite, with shadow to the left of it
+				int distance = std::abs(x - width / 2) + std::abs(y - height / 2);
+				if (!withTransparency || distance < width / 3)
+					row[x] = 8 + (x * 3 + y * 5) % 248;
+				else if (distance < width / 3 + 4)
+					row[x] = 4;
+				else if (distance < width / 3 + 6)
+					row[x] = 1;
+				else
+					row[x] = 0;
+			}
+		}
+		return sprite;
+	};
+
+	SDL_Surface * frame = CSDL_Ext::createSurfaceWithBpp<4>(frameSize.x, frameSize.y);
+	SDL_Surface * terrain = createSprite(tileSize, tileSize, false);
+	SDL_Surface * object = createSprite(tileSize * 3, tileSize * 2, true);
+
+	auto renderFrame = [&](int)
+	{
+		for(int y = 0; y < frameSize.y; y += tileSize)
+			for(int x = 0; x < frameSize.x; x += tileSize)
+				CSDL_Ext::blit8bppAlphaTo24bpp(terrain, Rect(0, 0, tileSize, tileSize), frame, Point(x, y), SDL_ALPHA_OPAQUE);
+
+		for(int y = 0; y < frameSize.y; y += tileSize * 2)
+			for(int x = 0; x < frameSize.x; x += tileSize * 4)
+				CSDL_Ext::blit8bppAlphaTo24bpp(object, Rect(0, 0, object->w, object->h), frame, Point(x, y), (x / tileSize) % 8 == 0 ? 128 : SDL_ALPHA_OPAQUE);
+	};
+
+	auto measure = [&](bool useSimd)
+	{
+		CSDL_Ext::setSimdBlitEnabled(useSimd);
+		return measureAverageTime(100, renderFrame);
+	};
+
+	bool wasEnabled = CSDL_Ext::isSimdBlitEnabled();
+	double scalarTime = measure(false);
+	double simdTime = measure(true);
+	CSDL_Ext::setSimdBlitEnabled(wasEnabled);
+
+	SDL_FreeSurface(object);
+	SDL_FreeSurface(terrain);
+	SDL_FreeSurface(frame);
+
+	std::string result;
+	if (!wasEnabled)
+		result += "Vectorized blitting is not supported on this platform\n";
+
+	result += boost::str(boost::format("Blitted adventure map frame of %dx%d: %.2f ms using scalar code, %.2f ms using vectorized code\n") % frameSize.x % frameSize.y % scalarTime % simdTime);
+	return result;
+}
@@ -0,0 +1,16 @@
+/*
+ * BlitBenchmark.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+namespace ClientBenchmarks
+{
+	/// compares drawing of adventure map frame from paletted images using scalar and vectorized blitting
+	std::string runBlitBenchmark();
+}
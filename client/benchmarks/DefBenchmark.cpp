@@ -0,0 +1,63 @@
+/*
+ * DefBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "DefBenchmark.h"
+
+#include "BenchmarkUtils.h"
+
+#include "../render/CDefFile.h"
+
+#include "../../lib/VCMI_Lib.h"
+#include "../../lib/entities/faction/CTown.h"
+#include "../../lib/entities/faction/CTownHandler.h"
+#include "../../lib/filesystem/CMappedFileStream.h"
+#include "../../lib/filesystem/Filesystem.h"
+
+std::string ClientBenchmarks::runDefBenchmark()
+{
+	std::set<AnimationPath> animations;
+	auto addAnimation = [&animations](const AnimationPath & path)
+	{
+		// same lookup as in RenderHandler - animations are located in SPRITES directory
+		animations.insert(boost::starts_with(path.getName(), "SPRITES") ? path : path.addPrefix("SPRITES/"));
+	};
+
+	for(const auto & faction : VLC->townh->objects)
+	{
+		if (!faction || !faction->hasTown())
+			continue;
+
+		addAnimation(faction->town->clientInfo.buildingsIcons);
+		for(const auto & structure : faction->town->clientInfo.structures)
+			addAnimation(structure->defName);
+	}
+
+	vstd::erase_if(animations, [](const AnimationPath & path)
+	{
+		return !CResourceHandler::get()->existsResource(path);
+	});
+
+	auto measure = [&animations](bool useMapping)
+	{
+		CMappedFile::setEnabled(useMapping);
+		return measureBestTime(5, [&animations](int)
+		{
+			for(const auto & path : animations)
+				CDefFile def(path);
+		});
+	};
+
+	bool wasEnabled = CMappedFile::isEnabled();
+	double fileTime = measure(false);
+	double mappedTime = measure(true);
+	CMappedFile::setEnabled(wasEnabled);
+
+	return boost::str(boost::format("Loaded %d town screen animations: %.1f ms using file streams, %.1f ms using memory-mapped files\n") % animations.size() % fileTime % mappedTime);
+}
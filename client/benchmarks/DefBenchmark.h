@@ -0,0 +1,16 @@
+/*
+ * DefBenchmark.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+namespace ClientBenchmarks
+{
+	/// compares loading time of town screen animations using file streams and memory-mapped files
+	std::string runDefBenchmark();
+}
@@ -0,0 +1,47 @@
+/*
+ * JsonBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "JsonBenchmark.h"
+
+#include "BenchmarkUtils.h"
+
+#include "../../lib/filesystem/Filesystem.h"
+#include "../../lib/json/JsonNode.h"
+
+std::string ClientBenchmarks::runJsonBenchmark()
+{
+	auto files = CResourceHandler::get()->getFilteredFiles([](const ResourcePath & ident)
+	{
+		return ident.getType() == EResType::JSON;
+	});
+
+	// load all versions of each file, including overridden ones, so parsing is measured without any I/O
+	std::vector<std::pair<std::string, std::pair<std::unique_ptr<ui8[]>, si64>>> fileData;
+	si64 totalSize = 0;
+
+	for(const auto & file : files)
+	{
+		for(const auto * loader : CResourceHandler::get()->getResourcesWithName(file))
+		{
+			fileData.emplace_back(file.getName(), loader->load(file)->readAll());
+			totalSize += fileData.back().second.second;
+		}
+	}
+
+	double time = measureBestTime(5, [&](int)
+	{
+		for(const auto & [name, data] : fileData)
+			JsonNode parsed(reinterpret_cast<const std::byte *>(data.first.get()), data.second, name);
+	});
+
+	double megabytes = totalSize / (1024.0 * 1024.0);
+	double seconds = std::max(time, 0.001) / 1000;
+	return boost::str(boost::format("Parsed %d json files, %.2f MB in %.1f ms, %.1f MB/s\n") % fileData.size() % megabytes % time % (megabytes / seconds));
+}
@@ -0,0 +1,16 @@
+/*
+ * JsonBenchmark.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+namespace ClientBenchmarks
+{
+	/// measures parsing speed of all json files available in loaded mods, without any I/O
+	std::string runJsonBenchmark();
+}
@@ -0,0 +1,87 @@
+/*
+ * PaletteBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "PaletteBenchmark.h"
+
+#include "BenchmarkUtils.h"
+
+#include "../gui/CGuiHandler.h"
+#include "../renderSDL/SDL_Extensions.h"
+
+#include <SDL_surface.h>
+
+std::string ClientBenchmarks::runPaletteBenchmark()
+{
+	// Uses only offscreen surfaces, so it can also be run with SDL_VIDEODRIVER=dummy
+	constexpr int tileSize = 32;
+	// water terrain: two ranges of cycled colors
+	constexpr std::array<std::pair<int, int>, 2> cycledRanges = {{ {229, 12}, {242, 14} }};
+	const Point frameSize = GH.screenDimensions();
+	const auto originalColors = createTestPalette();
+
+	SDL_Surface * frame = CSDL_Ext::createSurfaceWithBpp<4>(frameSize.x, frameSize.y);
+	SDL_Surface * terrain = SDL_CreateRGBSurface(0, tileSize, tileSize, 8, 0, 0, 0, 0);
+	SDL_Palette * originalPalette = SDL_AllocPalette(256);
+	SDL_Palette * instancePalette = SDL_AllocPalette(256);
+
+	SDL_SetPaletteColors(originalPalette, originalColors.data(), 0, 256);
+	SDL_SetPaletteColors(instancePalette, originalColors.data(), 0, 256);
+	SDL_SetSurfacePalette(terrain, originalPalette);
+
+	for(int y = 0; y < tileSize; ++y)
+		for(int x = 0; x < tileSize; ++x)
+			static_cast<uint8_t *>(terrain->pixels)[y * terrain->pitch + x] = 200 + (x * 3 + y * 5) % 56;
+
+	// previous approach: per-instance palette is attached to shared surface for duration of each blit
+	double surfacePaletteTime = measureAverageTime(100, [&](int frameIndex)
+	{
+		for(int y = 0; y < frameSize.y; y += tileSize)
+		{
+			for(int x = 0; x < frameSize.x; x += tileSize)
+			{
+				for(const auto & [first, length] : cycledRanges)
+				{
+					std::vector<SDL_Color> shifted(length);
+					for(int i = 0; i < length; ++i)
+						shifted[(i + frameIndex) % length] = originalColors[first + i];
+					SDL_SetPaletteColors(instancePalette, shifted.data(), first, length);
+				}
+
+				SDL_SetSurfacePalette(terrain, instancePalette);
+				CSDL_Ext::blitSurface(terrain, Rect(0, 0, tileSize, tileSize), frame, Point(x, y));
+				SDL_SetSurfacePalette(terrain, originalPalette);
+			}
+		}
+	});
+
+	// current approach: palette is only passed to blitter as indirection table, surface is never modified
+	auto colors = originalColors;
+	double indirectionTableTime = measureAverageTime(100, [&](int frameIndex)
+	{
+		for(int y = 0; y < frameSize.y; y += tileSize)
+		{
+			for(int x = 0; x < frameSize.x; x += tileSize)
+			{
+				for(const auto & [first, length] : cycledRanges)
+					for(int i = 0; i < length; ++i)
+						colors[first + (i + frameIndex) % length] = originalColors[first + i];
+
+				CSDL_Ext::blit8bppAlphaTo24bpp(terrain, Rect(0, 0, tileSize, tileSize), frame, Point(x, y), SDL_ALPHA_OPAQUE, colors.data());
+			}
+		}
+	});
+
+	SDL_FreeSurface(terrain);
+	SDL_FreePalette(instancePalette);
+	SDL_FreePalette(originalPalette);
+	SDL_FreeSurface(frame);
+
+	return boost::str(boost::format("Drawn palette-cycled terrain frame of %dx%d: %.2f ms with palette attached to surface, %.2f ms with indirection table\n") % frameSize.x % frameSize.y % surfacePaletteTime % indirectionTableTime);
+}
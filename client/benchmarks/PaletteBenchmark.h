@@ -0,0 +1,16 @@
+/*
+ * PaletteBenchmark.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+namespace ClientBenchmarks
+{
+	/// compares drawing of palette-cycled terrain with per-instance surface palette against palette passed to blitter
+	std::string runPaletteBenchmark();
+}
@@ -21,9 +21,12 @@
 #include "../gui/CGuiHandler.h"
 #include "../gui/CursorHandler.h"
 #include "../gui/EventDispatcher.h"
+#include "../gui/FrameProfiler.h"
 #include "../gui/MouseButton.h"
 #include "../media/IMusicPlayer.h"
 #include "../media/ISoundPlayer.h"
+#include "../render/IRenderHandler.h"
+#include "../render/IScreenHandler.h"
 #include "../CMT.h"
 #include "../CPlayerInterface.h"
 #include "../CGameInfo.h"
@@ -257,6 +260,19 @@ void InputHandler::preprocessEvent(const SDL_Event & ev)
 		}
 		return;
 	}
+	else if(ev.type == SDL_APP_WILLENTERBACKGROUND)
+	{
+		// mobile systems may terminate application in background without any further notice
+		GH.renderHandler().saveScaledImages();
+		return;
+	}
+	else if(ev.type == SDL_RENDER_TARGETS_RESET || ev.type == SDL_RENDER_DEVICE_RESET)
+	{
+		// content of screen texture may be lost, and only changed regions are uploaded on each frame
+		boost::mutex::scoped_lock interfaceLock(GH.interfaceMutex);
+		GH.screenHandler().invalidateScreenTexture();
+		return;
+	}
 	else if(ev.type == SDL_SYSWMEVENT)
 	{
 		boost::mutex::scoped_lock interfaceLock(GH.interfaceMutex);
@@ -324,6 +340,7 @@ void InputHandler::preprocessEvent(const SDL_Event & ev)
 
 void InputHandler::fetchEvents()
 {
+	FrameProfilerScope scope("fetch events");
 	SDL_Event ev;
 
 	while(1 == SDL_PollEvent(&ev))
@@ -14,18 +14,21 @@
 #include "CursorHandler.h"
 #include "ShortcutHandler.h"
 #include "FramerateManager.h"
+#include "FrameProfiler.h"
 #include "WindowHandler.h"
 #include "EventDispatcher.h"
 #include "../eventsSDL/InputHandler.h"
 
 #include "../CGameInfo.h"
 #include "../adventureMap/AdventureMapInterface.h"
+#include "../render/Canvas.h"
 #include "../render/Colors.h"
 #include "../render/Graphics.h"
 #include "../render/IFont.h"
 #include "../render/EFont.h"
 #include "../renderSDL/ScreenHandler.h"
 #include "../renderSDL/RenderHandler.h"
+#include "../renderSDL/SDL_Extensions.h"
 #include "../CMT.h"
 #include "../CPlayerInterface.h"
 #include "../battle/BattleInterface.h"
@@ -63,16 +66,21 @@ void CGuiHandler::init()
 	shortcutsHandlerInstance = std::make_unique<ShortcutHandler>();
 	inputHandlerInstance = std::make_unique<InputHandler>(); // Must be after windowHandlerInstance and shortcutsHandlerInstance
 	framerateManagerInstance = std::make_unique<FramerateManager>(settings["video"]["targetfps"].Integer());
+	frameProfilerInstance = std::make_unique<FrameProfiler>();
 }
 
 void CGuiHandler::handleEvents()
 {
-	events().dispatchTimer(framerate().getElapsedMilliseconds());
+	{
+		FrameProfilerScope scope("timers");
+		events().dispatchTimer(framerate().getElapsedMilliseconds());
+	}
 
 	//player interface may want special event handling
 	if(nullptr != LOCPLINT && LOCPLINT->capturedAllEvents())
 		return;
 
+	FrameProfilerScope scope("input");
 	input().processEvents();
 }
 
@@ -99,27 +107,42 @@ void CGuiHandler::renderFrame()
 		boost::mutex::scoped_lock interfaceLock(GH.interfaceMutex);
 
 		if (nullptr != curInt)
+		{
+			FrameProfilerScope scope("update");
 			curInt->update();
+		}
 
 		if (settings["video"]["showfps"].Bool())
 			drawFPSCounter();
 
-		SDL_UpdateTexture(screenTexture, nullptr, screen->pixels, screen->pitch);
-	}
+		Canvas overlayTarget = Canvas::createFromSurface(screen, CanvasScalingPolicy::AUTO);
+		profiler().renderOverlay(overlayTarget);
 
-	SDL_RenderClear(mainRenderer);
-	SDL_RenderCopy(mainRenderer, screenTexture, nullptr, nullptr);
+		FrameProfilerScope scope("texture upload");
+		screenHandler().updateScreenTexture();
+	}
 
 	{
-		boost::mutex::scoped_lock interfaceLock(GH.interfaceMutex);
+		FrameProfilerScope scope("present");
+		screenHandler().presentScreenTexture();
 
-		CCS->curh->render();
+		{
+			boost::mutex::scoped_lock interfaceLock(GH.interfaceMutex);
+
+			CCS->curh->render();
+
+			windows().onFrameRendered();
+		}
+
+		SDL_RenderPresent(mainRenderer);
+	}
 
-		windows().onFrameRendered();
+	{
+		FrameProfilerScope scope("frame delay");
+		framerate().framerateDelay(); // holds a constant FPS
 	}
 
-	SDL_RenderPresent(mainRenderer);
-	framerate().framerateDelay(); // holds a constant FPS
+	profiler().onFrameFinished();
 }
 
 CGuiHandler::CGuiHandler()
@@ -149,6 +172,11 @@ FramerateManager & CGuiHandler::framerate()
 	return *framerateManagerInstance;
 }
 
+FrameProfiler & CGuiHandler::profiler()
+{
+	return *frameProfilerInstance;
+}
+
 bool CGuiHandler::isKeyboardCtrlDown() const
 {
 	return inputHandlerInstance->isKeyboardCtrlDown();
@@ -181,18 +209,20 @@ Point CGuiHandler::screenDimensions() const
 
 void CGuiHandler::drawFPSCounter()
 {
+	std::string fps = std::to_string(framerate().getFramerate())+" FPS";
+	const auto & font = graphics->fonts[FONT_SMALL];
+
+	// logical coordinates of text and of box behind it, wide enough for 3-digit framerate
+	Point textPosition(8, screenDimensions().y - 22);
+	Rect overlay(textPosition - Point(1, 0), Point(std::max<int>(48, font->getStringWidth(fps) + 2), font->getLineHeight()));
+
 	int scaling = screenHandlerInstance->getScalingFactor();
-	int x = 7 * scaling;
-	int y = screen->h-20 * scaling;
-	int width3digitFPSIncludingPadding = 48 * scaling;
-	int heightFPSTextIncludingPadding = 11 * scaling;
-	SDL_Rect overlay = { x, y, width3digitFPSIncludingPadding, heightFPSTextIncludingPadding};
+	SDL_Rect scaledOverlay = CSDL_Ext::toSDL(overlay * scaling);
 	uint32_t black = SDL_MapRGB(screen->format, 10, 10, 10);
-	SDL_FillRect(screen, &overlay, black);
-
-	std::string fps = std::to_string(framerate().getFramerate())+" FPS";
+	SDL_FillRect(screen, &scaledOverlay, black);
 
-	graphics->fonts[FONT_SMALL]->renderTextLeft(screen, fps, Colors::WHITE, Point(8 * scaling, screen->h-22 * scaling));
+	font->renderTextLeft(screen, fps, Colors::WHITE, textPosition * scaling);
+	windows().addOverlayArea(overlay);
 }
 
 bool CGuiHandler::amIGuiThread()
@@ -17,6 +17,7 @@ VCMI_LIB_NAMESPACE_END
 enum class MouseButton;
 class ShortcutHandler;
 class FramerateManager;
+class FrameProfiler;
 class IStatusBar;
 class CIntObject;
 class IUpdateable;
@@ -43,6 +44,7 @@ private:
 	std::unique_ptr<IScreenHandler> screenHandlerInstance;
 	std::unique_ptr<IRenderHandler> renderHandlerInstance;
 	std::unique_ptr<FramerateManager> framerateManagerInstance;
+	std::unique_ptr<FrameProfiler> frameProfilerInstance;
 	std::unique_ptr<EventDispatcher> eventDispatcherInstance;
 	std::unique_ptr<InputHandler> inputHandlerInstance;
 
@@ -54,6 +56,7 @@ public:
 
 	ShortcutHandler & shortcuts();
 	FramerateManager & framerate();
+	FrameProfiler & profiler();
 	EventDispatcher & events();
 	InputHandler & input();
 
@@ -15,6 +15,7 @@
 #include "EventDispatcher.h"
 #include "Shortcut.h"
 #include "../render/Canvas.h"
+#include "../render/IScreenHandler.h"
 #include "../windows/CMessage.h"
 #include "../CMT.h"
 
@@ -247,10 +248,23 @@ void CIntObject::redraw()
 
 				showAll(screenBuffer);
 			}
+			GH.screenHandler().markDirty(getDrawnArea());
 		}
 	}
 }
 
+Rect CIntObject::getDrawnArea() const
+{
+	Rect result = pos;
+	for(const auto * child : children)
+	{
+		Rect childArea = child->getDrawnArea();
+		if (childArea.w > 0 && childArea.h > 0)
+			result = (result.w > 0 && result.h > 0) ? result.include(childArea) : childArea;
+	}
+	return result;
+}
+
 void CIntObject::moveChildForeground(const CIntObject * childToMove)
 {
 	for(auto child = children.begin(); child != children.end(); child++)
@@ -118,6 +118,9 @@ public:
 
 	const Rect & getPosition() const override;
 
+	/// returns area of screen in which this object may draw, including its children placed outside of it
+	Rect getDrawnArea() const;
+
 	const Rect & center(const Rect &r, bool propagate = true); //sets pos so that r will be in the center of screen, assigns sizes of r to pos, returns new position
 	const Rect & center(const Point &p, bool propagate = true);  //moves object so that point p will be in its center
 	const Rect & center(bool propagate = true); //centers when pos.w and pos.h are set, returns new position
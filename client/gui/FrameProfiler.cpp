@@ -0,0 +1,235 @@
+/*
+ * FrameProfiler.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "FrameProfiler.h"
+
+#include "CGuiHandler.h"
+#include "WindowHandler.h"
+
+#include "../render/Canvas.h"
+#include "../render/Colors.h"
+#include "../render/EFont.h"
+#include "../render/Graphics.h"
+#include "../render/IScreenHandler.h"
+#include "../render/IFont.h"
+
+#include "../../lib/CConfigHandler.h"
+
+/// statistics shown in overlay are updated only once per this number of frames, to keep them readable
+static constexpr size_t reportInterval = 30;
+
+FrameProfiler::FrameProfiler()
+	: creationTime(Clock::now())
+	, lastFrameTime(creationTime)
+{
+}
+
+FrameProfiler::~FrameProfiler()
+{
+	stopTrace();
+}
+
+void FrameProfiler::addMeasurement(const char * name, Clock::time_point start, Clock::time_point finish)
+{
+	auto & section = sectionsByName[name];
+	if(!section)
+		section = &sections[name];
+
+	section->currentFrame += finish - start;
+	writeTraceEvent(name, start, finish);
+}
+
+void FrameProfiler::writeTraceEvent(const char * name, Clock::time_point start, Clock::time_point finish)
+{
+	std::lock_guard lock(traceMutex);
+
+	if(!traceFile.is_open())
+		return;
+
+	auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(start - creationTime).count();
+	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+	traceFile << ",\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << timestamp << ",\"dur\":" << duration << "}";
+}
+
+void FrameProfiler::onFrameFinished()
+{
+	auto now = Clock::now();
+
+	bool wasOverlayShown = overlayShown;
+	overlayShown = settings["session"]["showFrameProfiler"].Bool();
+
+	// overlay is drawn directly on screen, and may not be covered by anything else once hidden
+	if(wasOverlayShown && !overlayShown)
+		GH.windows().totalRedraw();
+
+	if(enabled)
+	{
+		addMeasurement("frame", lastFrameTime, now);
+
+		size_t index = framesCount % historySize;
+		for(auto & section : sections)
+		{
+			section.second.history[index] = std::chrono::duration_cast<std::chrono::microseconds>(section.second.currentFrame).count();
+			section.second.currentFrame = Clock::duration::zero();
+		}
+
+		++framesCount;
+		if(framesCount % reportInterval == 0)
+			updateReport();
+	}
+
+	bool wasEnabled = enabled;
+	enabled = overlayShown || isTraceActive();
+
+	// discard statistics from previous profiling session
+	if(enabled && !wasEnabled)
+	{
+		sectionsByName.clear();
+		sections.clear();
+		report.clear();
+		framesCount = 0;
+	}
+
+	lastFrameTime = now;
+}
+
+void FrameProfiler::updateReport()
+{
+	report.clear();
+
+	size_t framesMeasured = std::min(framesCount, historySize);
+	size_t lastIndex = (framesCount - 1) % historySize;
+
+	for(const auto & [name, section] : sections)
+	{
+		std::vector<uint32_t> values(section.history.begin(), section.history.begin() + framesMeasured);
+		std::sort(values.begin(), values.end());
+
+		auto percentile = [&values](double fraction)
+		{
+			return values[static_cast<size_t>(fraction * (values.size() - 1) + 0.5)] / 1000.0;
+		};
+
+		ReportLine line;
+		line.name = name;
+		line.last = section.history[lastIndex] / 1000.0;
+		line.average = std::accumulate(values.begin(), values.end(), uint64_t(0)) / 1000.0 / values.size();
+		line.p50 = percentile(0.5);
+		line.p95 = percentile(0.95);
+		line.p99 = percentile(0.99);
+		line.max = values.back() / 1000.0;
+		report.push_back(line);
+	}
+
+	// whole frame first, followed by most expensive sections
+	std::sort(report.begin(), report.end(), [](const ReportLine & left, const ReportLine & right)
+	{
+		if((left.name == "frame") != (right.name == "frame"))
+			return left.name == "frame";
+		return left.average > right.average;
+	});
+}
+
+void FrameProfiler::renderOverlay(Canvas & target) const
+{
+	if(!overlayShown)
+		return;
+
+	constexpr int nameColumnWidth = 110;
+	constexpr int valueColumnWidth = 40;
+	constexpr int padding = 4;
+	constexpr std::array<const char *, 6> valueNames = { "last", "avg", "p50", "p95", "p99", "max" };
+
+	int lineHeight = graphics->fonts[FONT_SMALL]->getLineHeight();
+	Point origin(8, 8);
+	Rect background(origin, Point(nameColumnWidth + valueColumnWidth * valueNames.size() + padding * 2, lineHeight * (report.size() + 1) + padding * 2));
+
+	target.drawColorBlended(background, ColorRGBA(0, 0, 0, 192));
+	GH.windows().addOverlayArea(background);
+
+	auto drawLine = [&](int lineIndex, const std::string & name, const std::array<std::string, 6> & values, const ColorRGBA & color)
+	{
+		Point linePosition = origin + Point(padding, padding + lineIndex * lineHeight);
+		target.drawText(linePosition, FONT_SMALL, color, ETextAlignment::TOPLEFT, name);
+		for(size_t i = 0; i < values.size(); ++i)
+			target.drawText(linePosition + Point(nameColumnWidth + valueColumnWidth * (i + 1), 0), FONT_SMALL, color, ETextAlignment::TOPRIGHT, values[i]);
+	};
+
+	drawLine(0, "ms", { valueNames[0], valueNames[1], valueNames[2], valueNames[3], valueNames[4], valueNames[5] }, Colors::YELLOW);
+
+	auto format = [](double value)
+	{
+		return boost::str(boost::format("%.2f") % value);
+	};
+
+	for(size_t i = 0; i < report.size(); ++i)
+	{
+		const auto & line = report[i];
+		drawLine(i + 1, line.name, { format(line.last), format(line.average), format(line.p50), format(line.p95), format(line.p99), format(line.max) }, Colors::WHITE);
+	}
+}
+
+bool FrameProfiler::startTrace(const boost::filesystem::path & path)
+{
+	stopTrace();
+
+	std::lock_guard lock(traceMutex);
+
+	traceFile.open(path.c_str(), std::ofstream::out | std::ofstream::trunc);
+	if(!traceFile)
+	{
+		traceFile.close();
+		logGlobal->error("Failed to open file %s for writing frame trace", path.string());
+		return false;
+	}
+
+	tracePath = path;
+	traceFile << "{\"traceEvents\":[\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"MainGUI\"}}";
+	logGlobal->info("Writing frame trace to %s", path.string());
+	return true;
+}
+
+void FrameProfiler::stopTrace()
+{
+	std::lock_guard lock(traceMutex);
+
+	if(!traceFile.is_open())
+		return;
+
+	traceFile << "\n]}\n";
+	traceFile.close();
+	logGlobal->info("Frame trace was written to %s", tracePath.string());
+}
+
+bool FrameProfiler::isTraceActive() const
+{
+	std::lock_guard lock(traceMutex);
+	return traceFile.is_open();
+}
+
+const boost::filesystem::path & FrameProfiler::getTracePath() const
+{
+	return tracePath;
+}
+
+FrameProfilerScope::FrameProfilerScope(const char * name)
+	: name(name)
+	, active(GH.amIGuiThread() && GH.profiler().isEnabled())
+{
+	if(active)
+		start = FrameProfiler::Clock::now();
+}
+
+FrameProfilerScope::~FrameProfilerScope()
+{
+	if(active)
+		GH.profiler().addMeasurement(name, start, FrameProfiler::Clock::now());
+}
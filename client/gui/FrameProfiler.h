@@ -0,0 +1,107 @@
+/*
+ * FrameProfiler.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+class Canvas;
+
+/// Collects time spent by main loop and rendering subsystems on each frame
+/// Statistics of recent frames can be shown in overlay, and all measurements can be written to file in Chrome trace event format
+/// Measurements are only collected in main (GUI) thread
+class FrameProfiler : boost::noncopyable
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+private:
+	/// number of last frames used to compute statistics
+	static constexpr size_t historySize = 300;
+
+	struct SectionStatistics
+	{
+		/// time spent in section during current frame
+		Clock::duration currentFrame = Clock::duration::zero();
+		/// cyclic buffer of time spent in section during last frames, in microseconds
+		std::array<uint32_t, historySize> history = {};
+	};
+
+	struct ReportLine
+	{
+		std::string name;
+		double last;
+		double average;
+		double p50;
+		double p95;
+		double p99;
+		double max;
+	};
+
+	std::map<std::string, SectionStatistics> sections;
+	/// sections by address of their name, to avoid string construction and comparison on every measurement
+	/// same name used in different places may have different addresses, all of them point to same section
+	std::unordered_map<const char *, SectionStatistics *> sectionsByName;
+	std::vector<ReportLine> report;
+
+	Clock::time_point creationTime;
+	Clock::time_point lastFrameTime;
+	size_t framesCount = 0;
+
+	bool enabled = false;
+	bool overlayShown = false;
+
+	boost::filesystem::path tracePath;
+	std::ofstream traceFile;
+	mutable std::mutex traceMutex;
+
+	void writeTraceEvent(const char * name, Clock::time_point start, Clock::time_point finish);
+	void updateReport();
+
+public:
+	FrameProfiler();
+	~FrameProfiler();
+
+	/// returns true if measurements are collected, either for overlay or for trace
+	bool isEnabled() const
+	{
+		return enabled;
+	}
+
+	/// records time spent in section with specified name. Multiple measurements of same section within a frame are summed up
+	void addMeasurement(const char * name, Clock::time_point start, Clock::time_point finish);
+
+	/// must be called once per frame, after frame has been presented
+	void onFrameFinished();
+
+	/// draws table with statistics of all sections if overlay is enabled in settings
+	void renderOverlay(Canvas & target) const;
+
+	/// starts writing all measurements to specified file. Returns false if file can not be opened
+	bool startTrace(const boost::filesystem::path & path);
+
+	/// finishes writing of trace file, if any
+	void stopTrace();
+
+	bool isTraceActive() const;
+
+	/// path of file in which trace is written or was written last
+	const boost::filesystem::path & getTracePath() const;
+};
+
+/// Measures time between its construction and destruction and reports it to frame profiler
+class FrameProfilerScope : boost::noncopyable
+{
+	const char * name;
+	FrameProfiler::Clock::time_point start;
+	bool active;
+
+public:
+	/// name must be a string literal or otherwise outlive profiler
+	explicit FrameProfilerScope(const char * name);
+	~FrameProfilerScope();
+};
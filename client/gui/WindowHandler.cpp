@@ -13,11 +13,13 @@
 #include "CGuiHandler.h"
 #include "CIntObject.h"
 #include "CursorHandler.h"
+#include "FrameProfiler.h"
 
 #include "../CMT.h"
 #include "../CGameInfo.h"
 #include "../render/Canvas.h"
 #include "../render/Colors.h"
+#include "../render/IScreenHandler.h"
 #include "../renderSDL/SDL_Extensions.h"
 
 void WindowHandler::popWindow(std::shared_ptr<IShowActivatable> top)
@@ -116,10 +118,16 @@ void WindowHandler::totalRedrawImpl()
 	for(auto & elem : windowsStack)
 		elem->showAll(target);
 	CSDL_Ext::blitAt(screen2, 0, 0, screen);
+
+	GH.screenHandler().invalidateScreenTexture();
+	drawnArea = Rect();
+	overlayAreas.clear();
 }
 
 void WindowHandler::simpleRedraw()
 {
+	FrameProfilerScope scope("windows redraw");
+
 	if (totalRedrawRequested)
 		totalRedrawImpl();
 	else
@@ -128,16 +136,53 @@ void WindowHandler::simpleRedraw()
 	totalRedrawRequested = false;
 }
 
+Rect WindowHandler::getTopWindowArea() const
+{
+	const Rect screenArea(Point(0, 0), GH.screenDimensions());
+
+	if (windowsStack.empty())
+		return Rect();
+
+	const auto topWindow = std::dynamic_pointer_cast<CIntObject>(windowsStack.back());
+
+	if (!topWindow)
+		return screenArea;
+
+	return topWindow->getDrawnArea().intersect(screenArea);
+}
+
 void WindowHandler::simpleRedrawImpl()
 {
+	// Background outside of top window is modified by redraw() calls, which update both screen buffers,
+	// and by overlays drawn directly on screen, which are registered in overlayAreas
+	// So only area of top window and of overlays from previous frame needs to be restored and uploaded
+	Rect windowArea = getTopWindowArea();
+	Rect area = (drawnArea.w > 0 && drawnArea.h > 0) ? windowArea.include(drawnArea) : windowArea;
+	int scaling = GH.screenHandler().getScalingFactor();
+
 	//update only top interface and draw background
 	if(windowsStack.size() > 1)
-		CSDL_Ext::blitAt(screen2, 0, 0, screen); //blit background
+	{
+		Rect scaledArea = area * scaling;
+		CSDL_Ext::blitSurface(screen2, scaledArea, screen, scaledArea.topLeft()); //blit background
+	}
+
+	// overlays may be blended with screen content, or not drawn at all on this frame - always start from clean background
+	for(const auto & overlay : overlayAreas)
+	{
+		Rect scaledOverlay = overlay * scaling;
+		CSDL_Ext::blitSurface(screen2, scaledOverlay, screen, scaledOverlay.topLeft());
+		GH.screenHandler().markDirty(overlay);
+	}
+	overlayAreas.clear();
 
 	Canvas target = Canvas::createFromSurface(screen, CanvasScalingPolicy::AUTO);
 
 	if(!windowsStack.empty())
 		windowsStack.back()->show(target); //blit active interface/window
+
+	GH.screenHandler().markDirty(area);
+	drawnArea = windowArea;
 }
 
 void WindowHandler::onScreenResize()
@@ -153,6 +198,19 @@ void WindowHandler::onFrameRendered()
 	disposed.clear();
 }
 
+void WindowHandler::addOverlayArea(const Rect & area)
+{
+	GH.screenHandler().markDirty(area);
+
+	bool alreadyAdded = vstd::contains_if(overlayAreas, [&area](const Rect & entry)
+	{
+		return entry.topLeft() == area.topLeft() && entry.dimensions() == area.dimensions();
+	});
+
+	if(!alreadyAdded)
+		overlayAreas.push_back(area);
+}
+
 size_t WindowHandler::count() const
 {
 	return windowsStack.size();
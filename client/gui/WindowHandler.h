@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include "../../lib/Rect.h"
+
 class IShowActivatable;
 
 class WindowHandler
@@ -22,6 +24,15 @@ class WindowHandler
 
 	bool totalRedrawRequested = false;
 
+	/// area of screen, in logical coordinates, in which top window was drawn on previous frame
+	Rect drawnArea;
+
+	/// areas of screen, in logical coordinates, with overlays that were drawn on top of all windows on previous frame
+	std::vector<Rect> overlayAreas;
+
+	/// returns area of screen that may be modified by top window, including its children placed outside of it
+	Rect getTopWindowArea() const;
+
 	/// returns top windows
 	std::shared_ptr<IShowActivatable> topWindowImpl() const;
 
@@ -68,6 +79,10 @@ public:
 	/// should be called after frame has been rendered to screen
 	void onFrameRendered();
 
+	/// registers overlay drawn directly on screen on top of all windows, such as fps counter
+	/// area is uploaded on this frame and restored from background buffer on next one
+	void addOverlayArea(const Rect & area);
+
 	/// returns current number of windows in the stack
 	size_t count() const;
 
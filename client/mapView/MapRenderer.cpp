@@ -119,6 +119,15 @@ void MapTileStorage::load(size_t index, const AnimationPath & filename, EImageBl
 
 	if (terrainAnimations[3])
 		terrainAnimations[3]->horizontalFlip();
+
+	// all rotations of all tiles are packed into single atlas
+	std::vector<ImageLocator> locators;
+	for(const auto & entry : terrainAnimations)
+	{
+		if (entry)
+			vstd::concatenate(locators, entry->getImageLocators(0));
+	}
+	GH.renderHandler().createAtlas(locators);
 }
 
 std::shared_ptr<IImage> MapTileStorage::find(size_t fileIndex, size_t rotationIndex, size_t imageIndex)
@@ -413,6 +422,8 @@ std::shared_ptr<CAnimation> MapRendererObjects::getAnimation(const AnimationPath
 		ret->createFlippedGroup(7, 11);
 		ret->createFlippedGroup(8, 12);
 	}
+
+	ret->createAtlas();
 	return ret;
 }
 
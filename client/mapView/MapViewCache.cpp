@@ -23,26 +23,38 @@
 #include "../render/Graphics.h"
 
 #include "../gui/CGuiHandler.h"
+#include "../gui/FrameProfiler.h"
 #include "../widgets/TextControls.h"
 
 #include "../../lib/mapObjects/CObjectHandler.h"
+#include "../../lib/mapObjects/CGObjectInstance.h"
 #include "../../lib/int3.h"
 
+#include <tbb/parallel_for.h>
+
+/// number of tiles that are rendered before scaling them in parallel
+static constexpr size_t tilesPerBatch = 64;
+
 MapViewCache::~MapViewCache() = default;
 
 MapViewCache::MapViewCache(const std::shared_ptr<MapViewModel> & model)
 	: model(model)
 	, cachedLevel(0)
+	, cachedImagesVersion(GH.renderHandler().getImagesVersion())
 	, overlayWasVisible(false)
 	, mapRenderer(new MapRenderer())
 	, iconsStorage(GH.renderHandler().loadAnimation(AnimationPath::builtin("VwSymbol"), EImageBlitMode::COLORKEY))
-	, intermediate(new Canvas(Point(32, 32), CanvasScalingPolicy::AUTO))
 	, terrain(new Canvas(model->getCacheDimensionsPixels(), CanvasScalingPolicy::AUTO))
 	, terrainTransition(new Canvas(model->getPixelsVisibleDimensions(), CanvasScalingPolicy::AUTO))
 {
 	Point visibleSize = model->getTilesVisibleDimensions();
 	terrainChecksum.resize(boost::extents[visibleSize.x][visibleSize.y]);
 	tilesUpToDate.resize(boost::extents[visibleSize.x][visibleSize.y]);
+	tilesWithPlaceholders.resize(boost::extents[visibleSize.x][visibleSize.y]);
+	tileObjects.resize(boost::extents[visibleSize.x][visibleSize.y]);
+
+	for(size_t i = 0; i < tilesPerBatch; ++i)
+		intermediates.push_back(std::make_unique<Canvas>(Point(32, 32), CanvasScalingPolicy::AUTO));
 }
 
 Canvas MapViewCache::getTile(const int3 & coordinates)
@@ -59,23 +71,68 @@ std::shared_ptr<IImage> MapViewCache::getOverlayImageForTile(const std::shared_p
 	return nullptr;
 }
 
+void MapViewCache::invalidateTile(const std::shared_ptr<IMapRendererContext> & context, const int3 & coordinates, const ObjectInstanceID & object)
+{
+	if(coordinates.z != cachedLevel || !context->isInMap(coordinates) || !vstd::contains(context->getObjects(coordinates), object))
+		return;
+
+	int cacheX = (terrainChecksum.shape()[0] + coordinates.x) % terrainChecksum.shape()[0];
+	int cacheY = (terrainChecksum.shape()[1] + coordinates.y) % terrainChecksum.shape()[1];
+	auto & entry = terrainChecksum[cacheX][cacheY];
+
+	if(entry.tileX == coordinates.x && entry.tileY == coordinates.y)
+		entry = TileChecksum{};
+}
+
 void MapViewCache::invalidate(const std::shared_ptr<IMapRendererContext> & context, const ObjectInstanceID & object)
 {
-	for(size_t cacheY = 0; cacheY < terrainChecksum.shape()[1]; ++cacheY)
+	// tiles on which object was present when they were rendered
+	auto it = objectTiles.find(object);
+	if(it != objectTiles.end())
 	{
-		for(size_t cacheX = 0; cacheX < terrainChecksum.shape()[0]; ++cacheX)
-		{
-			auto & entry = terrainChecksum[cacheX][cacheY];
+		for(const auto & tile : it->second)
+			invalidateTile(context, tile, object);
+	}
+
+	// tiles on which object is present now, e.g. for newly added objects
+	const auto * instance = context->getObject(object);
+	if(instance)
+	{
+		for(int fx = 0; fx < instance->getWidth(); ++fx)
+			for(int fy = 0; fy < instance->getHeight(); ++fy)
+				invalidateTile(context, int3(instance->pos.x - fx, instance->pos.y - fy, instance->pos.z), object);
+	}
+}
 
-			int3 tile(entry.tileX, entry.tileY, cachedLevel);
+void MapViewCache::updateTileObjects(const std::shared_ptr<IMapRendererContext> & context, const int3 & coordinates)
+{
+	static const IMapRendererContext::MapObjectsList noObjects;
 
-			if(context->isInMap(tile) && vstd::contains(context->getObjects(tile), object))
-				entry = TileChecksum{};
-		}
+	int cacheX = (terrainChecksum.shape()[0] + coordinates.x) % terrainChecksum.shape()[0];
+	int cacheY = (terrainChecksum.shape()[1] + coordinates.y) % terrainChecksum.shape()[1];
+
+	auto & entry = tileObjects[cacheX][cacheY];
+	const auto & newObjects = context->isInMap(coordinates) ? context->getObjects(coordinates) : noObjects;
+
+	if(entry.coordinates == coordinates && entry.objects == newObjects)
+		return;
+
+	for(const auto & object : entry.objects)
+	{
+		auto & tiles = objectTiles[object];
+		tiles.erase(entry.coordinates);
+		if(tiles.empty())
+			objectTiles.erase(object);
 	}
+
+	for(const auto & object : newObjects)
+		objectTiles[object].insert(coordinates);
+
+	entry.coordinates = coordinates;
+	entry.objects = newObjects;
 }
 
-void MapViewCache::updateTile(const std::shared_ptr<IMapRendererContext> & context, const int3 & coordinates)
+bool MapViewCache::updateTileChecksum(const std::shared_ptr<IMapRendererContext> & context, const int3 & coordinates)
 {
 	int cacheX = (terrainChecksum.shape()[0] + coordinates.x) % terrainChecksum.shape()[0];
 	int cacheY = (terrainChecksum.shape()[1] + coordinates.y) % terrainChecksum.shape()[1];
@@ -88,31 +145,79 @@ void MapViewCache::updateTile(const std::shared_ptr<IMapRendererContext> & conte
 	newCacheEntry.checksum = mapRenderer->getTileChecksum(*context, coordinates);
 
 	if(cachedLevel == coordinates.z && oldCacheEntry == newCacheEntry && !context->tileAnimated(coordinates))
-		return;
+		return false;
+
+	updateTileObjects(context, coordinates);
 
+	oldCacheEntry = newCacheEntry;
+	tilesUpToDate[cacheX][cacheY] = false;
+	return true;
+}
+
+void MapViewCache::renderTileImages(const std::shared_ptr<IMapRendererContext> & context, Canvas & target, const int3 & coordinates)
+{
+	int cacheX = (terrainChecksum.shape()[0] + coordinates.x) % terrainChecksum.shape()[0];
+	int cacheY = (terrainChecksum.shape()[1] + coordinates.y) % terrainChecksum.shape()[1];
+	uint32_t placeholderDraws = GH.renderHandler().getPlaceholderDrawsCount();
+
+	mapRenderer->renderTile(*context, target, coordinates);
+
+	tilesWithPlaceholders[cacheX][cacheY] = placeholderDraws != GH.renderHandler().getPlaceholderDrawsCount();
+}
+
+void MapViewCache::renderTile(const std::shared_ptr<IMapRendererContext> & context, const int3 & coordinates)
+{
 	Canvas target = getTile(coordinates);
 
-	if(model->getSingleTileSize() == Point(32, 32))
-	{
-		mapRenderer->renderTile(*context, target, coordinates);
-	}
-	else
-	{
-		mapRenderer->renderTile(*context, *intermediate, coordinates);
-		target.drawScaled(*intermediate, Point(0, 0), model->getSingleTileSize());
-	}
+	renderTileImages(context, target, coordinates);
 
 	if(context->filterGrayscale())
 		target.applyGrayscale();
+}
 
-	oldCacheEntry = newCacheEntry;
-	tilesUpToDate[cacheX][cacheY] = false;
+void MapViewCache::renderTilesScaled(const std::shared_ptr<IMapRendererContext> & context, const std::vector<int3> & tiles)
+{
+	// Images share their surface state between all users, so tiles are rendered in original size sequentially
+	// Scaling into cache is done in parallel - each tile has its own intermediate canvas and its own region of terrain canvas
+	// Canvas objects modify reference counter of their surface, so they must be created and destroyed outside of parallel section
+	// SDL blitting modifies blit map of its surfaces as well, so scaling is done using plain pixel copy
+	for(size_t batchStart = 0; batchStart < tiles.size(); batchStart += tilesPerBatch)
+	{
+		size_t batchSize = std::min(tiles.size() - batchStart, tilesPerBatch);
+		std::vector<Canvas> targets;
+		targets.reserve(batchSize);
+
+		for(size_t i = 0; i < batchSize; ++i)
+		{
+			renderTileImages(context, *intermediates[i], tiles[batchStart + i]);
+			targets.push_back(getTile(tiles[batchStart + i]));
+		}
+
+		Point tileSize = model->getSingleTileSize();
+		bool grayscale = context->filterGrayscale();
+
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, batchSize), [&](const tbb::blocked_range<size_t> & range)
+		{
+			for(size_t i = range.begin(); i != range.end(); ++i)
+			{
+				targets[i].copyScaled(*intermediates[i], Point(0, 0), tileSize);
+
+				if(grayscale)
+					targets[i].applyGrayscale();
+			}
+		});
+	}
 }
 
 void MapViewCache::update(const std::shared_ptr<IMapRendererContext> & context)
 {
+	FrameProfilerScope scope("map view cache");
+
 	Rect dimensions = model->getTilesTotalRect();
 	bool mapResized = cachedSize != model->getSingleTileSize();
+	bool imagesUpdated = cachedImagesVersion != GH.renderHandler().getImagesVersion();
+
+	cachedImagesVersion = GH.renderHandler().getImagesVersion();
 
 	if(mapResized || dimensions.w != terrainChecksum.shape()[0] || dimensions.h != terrainChecksum.shape()[1])
 	{
@@ -128,11 +233,50 @@ void MapViewCache::update(const std::shared_ptr<IMapRendererContext> & context)
 		newCache.resize(boost::extents[dimensions.w][dimensions.h]);
 		tilesUpToDate.resize(boost::extents[dimensions.w][dimensions.h]);
 		tilesUpToDate = newCache;
+		tilesWithPlaceholders.resize(boost::extents[dimensions.w][dimensions.h]);
+		tilesWithPlaceholders = newCache;
 	}
 
+	if(imagesUpdated)
+	{
+		// only tiles that were drawn with placeholders may look differently with final images
+		for(size_t x = 0; x < tilesWithPlaceholders.shape()[0]; ++x)
+		{
+			for(size_t y = 0; y < tilesWithPlaceholders.shape()[1]; ++y)
+			{
+				if(tilesWithPlaceholders[x][y])
+					terrainChecksum[x][y] = TileChecksum{};
+				tilesWithPlaceholders[x][y] = false;
+			}
+		}
+	}
+
+	if(mapResized || dimensions.w != tileObjects.shape()[0] || dimensions.h != tileObjects.shape()[1])
+	{
+		boost::multi_array<TileObjects, 2> newCache;
+		newCache.resize(boost::extents[dimensions.w][dimensions.h]);
+		tileObjects.resize(boost::extents[dimensions.w][dimensions.h]);
+		tileObjects = newCache;
+		objectTiles.clear();
+	}
+
+	std::vector<int3> outdatedTiles;
+
+	// checksums are computed on main thread - renderer lazily loads animations into its shared caches while computing them
 	for(int y = dimensions.top(); y < dimensions.bottom(); ++y)
 		for(int x = dimensions.left(); x < dimensions.right(); ++x)
-			updateTile(context, {x, y, model->getLevel()});
+			if(updateTileChecksum(context, {x, y, model->getLevel()}))
+				outdatedTiles.emplace_back(x, y, model->getLevel());
+
+	if(model->getSingleTileSize() == Point(32, 32))
+	{
+		for(const auto & tile : outdatedTiles)
+			renderTile(context, tile);
+	}
+	else
+	{
+		renderTilesScaled(context, outdatedTiles);
+	}
 
 	cachedSize = model->getSingleTileSize();
 	cachedLevel = model->getLevel();
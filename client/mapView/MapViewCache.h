@@ -10,10 +10,8 @@
 #pragma once
 
 #include "../../lib/Point.h"
-
-VCMI_LIB_NAMESPACE_BEGIN
-class ObjectInstanceID;
-VCMI_LIB_NAMESPACE_END
+#include "../../lib/int3.h"
+#include "../../lib/constants/EntityIdentifiers.h"
 
 class IImage;
 class CAnimation;
@@ -40,23 +38,47 @@ class MapViewCache
 
 	boost::multi_array<TileChecksum, 2> terrainChecksum;
 	boost::multi_array<bool, 2> tilesUpToDate;
+	/// tiles that were rendered using placeholders of images that were still upscaled in background
+	boost::multi_array<bool, 2> tilesWithPlaceholders;
+
+	struct TileObjects
+	{
+		int3 coordinates = int3(-1);
+		std::vector<ObjectInstanceID> objects;
+	};
+
+	/// objects that were present on each cached tile when it was rendered
+	boost::multi_array<TileObjects, 2> tileObjects;
+	/// reverse index of tileObjects - all rendered tiles that contain specific object
+	std::map<ObjectInstanceID, std::set<int3>> objectTiles;
 
 	Point cachedSize;
 	Point cachedPosition;
 	int cachedLevel;
+	/// version of loaded images at the moment of last update, tiles with placeholders must be rendered again once background upscaling finishes
+	uint32_t cachedImagesVersion;
 	bool overlayWasVisible;
 
 	std::shared_ptr<MapViewModel> model;
 
 	std::unique_ptr<Canvas> terrain;
 	std::unique_ptr<Canvas> terrainTransition;
-	std::unique_ptr<Canvas> intermediate;
+	/// canvases for rendering of tiles in original size before scaling, one per tile in batch
+	std::vector<std::unique_ptr<Canvas>> intermediates;
 	std::unique_ptr<MapRenderer> mapRenderer;
 
 	std::shared_ptr<CAnimation> iconsStorage;
 
 	Canvas getTile(const int3 & coordinates);
-	void updateTile(const std::shared_ptr<IMapRendererContext> & context, const int3 & coordinates);
+
+	/// updates checksum of a tile, returns true if tile needs to be rendered again
+	bool updateTileChecksum(const std::shared_ptr<IMapRendererContext> & context, const int3 & coordinates);
+	void updateTileObjects(const std::shared_ptr<IMapRendererContext> & context, const int3 & coordinates);
+	void invalidateTile(const std::shared_ptr<IMapRendererContext> & context, const int3 & coordinates, const ObjectInstanceID & object);
+	void renderTile(const std::shared_ptr<IMapRendererContext> & context, const int3 & coordinates);
+	/// renders tile into target canvas in original size and remembers whether any of its images was not ready yet
+	void renderTileImages(const std::shared_ptr<IMapRendererContext> & context, Canvas & target, const int3 & coordinates);
+	void renderTilesScaled(const std::shared_ptr<IMapRendererContext> & context, const std::vector<int3> & tiles);
 
 	std::shared_ptr<IImage> getOverlayImageForTile(const std::shared_ptr<IMapRendererContext> & context, const int3 & coordinates);
 
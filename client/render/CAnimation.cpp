@@ -31,9 +31,13 @@ bool CAnimation::loadFrame(size_t frame, size_t group)
 
 	std::shared_ptr<IImage> image = GH.renderHandler().loadImage(getImageLocator(frame, group), mode);
 
+	auto & groupImages = images[group];
+	if (groupImages.size() <= frame)
+		groupImages.resize(size(group));
+
 	if(image)
 	{
-		images[group][frame] = image;
+		groupImages[frame] = image;
 
 		if (player.isValidPlayer())
 			image->playerColored(player);
@@ -43,20 +47,17 @@ bool CAnimation::loadFrame(size_t frame, size_t group)
 	{
 		// image is missing
 		printError(frame, group, "LoadFrame");
-		images[group][frame] = GH.renderHandler().loadImage(ImagePath::builtin("DEFAULT"), EImageBlitMode::OPAQUE);
+		groupImages[frame] = GH.renderHandler().loadImage(ImagePath::builtin("DEFAULT"), EImageBlitMode::OPAQUE);
 		return false;
 	}
 }
 
 bool CAnimation::unloadFrame(size_t frame, size_t group)
 {
-	auto image = getImage(frame, group, false);
+	auto image = getImageImpl(frame, group, false);
 	if(image)
 	{
-		images[group].erase(frame);
-
-		if(images[group].empty())
-			images.erase(group);
+		images[group][frame] = nullptr;
 		return true;
 	}
 	return false;
@@ -79,10 +80,11 @@ void CAnimation::exportBitmaps(const boost::filesystem::path& path) const
 	{
 		size_t group = groupPair.first;
 
-		for(const auto & imagePair : groupPair.second)
+		for(size_t frame = 0; frame < groupPair.second.size(); ++frame)
 		{
-			size_t frame = imagePair.first;
-			const auto img = imagePair.second;
+			const auto img = groupPair.second[frame];
+			if(!img)
+				continue;
 
 			boost::format fmt("%d_%d.bmp");
 			fmt % group % frame;
@@ -127,12 +129,9 @@ std::shared_ptr<IImage> CAnimation::getImage(size_t frame, size_t group, bool ve
 std::shared_ptr<IImage> CAnimation::getImageImpl(size_t frame, size_t group, bool verbose)
 {
 	auto groupIter = images.find(group);
-	if (groupIter != images.end())
-	{
-		auto imageIter = groupIter->second.find(frame);
-		if (imageIter != groupIter->second.end())
-			return imageIter->second;
-	}
+	if (groupIter != images.end() && frame < groupIter->second.size() && groupIter->second[frame])
+		return groupIter->second[frame];
+
 	if (verbose)
 		printError(frame, group, "GetImage");
 	return nullptr;
@@ -163,13 +162,8 @@ void CAnimation::verticalFlip()
 void CAnimation::horizontalFlip(size_t frame, size_t group)
 {
 	auto i1 = images.find(group);
-	if(i1 != images.end())
-	{
-		auto i2 = i1->second.find(frame);
-
-		if(i2 != i1->second.end())
-			i2->second = nullptr;
-	}
+	if(i1 != images.end() && frame < i1->second.size())
+		i1->second[frame] = nullptr;
 
 	auto locator = getImageLocator(frame, group);
 	locator.horizontalFlip = !locator.horizontalFlip;
@@ -179,13 +173,8 @@ void CAnimation::horizontalFlip(size_t frame, size_t group)
 void CAnimation::verticalFlip(size_t frame, size_t group)
 {
 	auto i1 = images.find(group);
-	if(i1 != images.end())
-	{
-		auto i2 = i1->second.find(frame);
-
-		if(i2 != i1->second.end())
-			i2->second = nullptr;
-	}
+	if(i1 != images.end() && frame < i1->second.size())
+		i1->second[frame] = nullptr;
 
 	auto locator = getImageLocator(frame, group);
 	locator.verticalFlip = !locator.verticalFlip;
@@ -197,7 +186,8 @@ void CAnimation::playerColored(PlayerColor targetPlayer)
 	player = targetPlayer;
 	for(auto & group : images)
 		for(auto & image : group.second)
-			image.second->playerColored(player);
+			if(image)
+				image->playerColored(player);
 }
 
 void CAnimation::createFlippedGroup(const size_t sourceGroup, const size_t targetGroup)
@@ -218,3 +208,20 @@ ImageLocator CAnimation::getImageLocator(size_t frame, size_t group) const
 
 	return ImageLocator(name, frame, group);
 }
+
+std::vector<ImageLocator> CAnimation::getImageLocators(size_t group) const
+{
+	std::vector<ImageLocator> result;
+	for(size_t frame = 0; frame < size(group); ++frame)
+		result.push_back(getImageLocator(frame, group));
+	return result;
+}
+
+void CAnimation::createAtlas()
+{
+	for(const auto & group : source)
+	{
+		if(GH.renderHandler().createAtlas(getImageLocators(group.first)))
+			images.erase(group.first);
+	}
+}
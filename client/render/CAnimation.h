@@ -29,8 +29,8 @@ private:
 	//source[group][position] - location of this frame
 	std::map<size_t, std::vector <ImageLocator> > source;
 
-	//bitmap[group][position], store objects with loaded bitmaps
-	std::map<size_t, std::map<size_t, std::shared_ptr<IImage> > > images;
+	//bitmap[group][position], store objects with loaded bitmaps, nullptr if frame is not loaded
+	std::map<size_t, std::vector<std::shared_ptr<IImage> > > images;
 
 	//animation file name
 	AnimationPath name;
@@ -74,5 +74,11 @@ public:
 	void playerColored(PlayerColor player);
 
 	void createFlippedGroup(const size_t sourceGroup, const size_t targetGroup);
+
+	//locators of all frames in group, in order of frames
+	std::vector<ImageLocator> getImageLocators(size_t group) const;
+
+	//packs frames of each group into shared atlas surface, if atlases are enabled. Frames that are already loaded will be reloaded from atlas
+	void createAtlas();
 };
 
@@ -40,17 +40,25 @@ CDefFile::CDefFile(const AnimationPath & Name):
 	data(nullptr),
 	palette(nullptr)
 {
-	data = CResourceHandler::get()->load(Name)->readAll().first;
+	stream = CResourceHandler::get()->load(Name);
+	data = stream->getSpan().first;
+
+	if (data == nullptr)
+	{
+		buffer = stream->readAll().first;
+		data = buffer.get();
+		stream.reset();
+	}
 
 	palette = std::unique_ptr<SDL_Color[]>(new SDL_Color[256]);
 	int it = 0;
 
-	//ui32 type = read_le_u32(data.get() + it);
+	//ui32 type = read_le_u32(data + it);
 	it+=4;
 	//int width  = read_le_u32(data + it); it+=4;//not used
 	//int height = read_le_u32(data + it); it+=4;
 	it+=8;
-	ui32 totalBlocks = read_le_u32(data.get() + it);
+	ui32 totalBlocks = read_le_u32(data + it);
 	it+=4;
 
 	for (ui32 i= 0; i<256; i++)
@@ -63,9 +71,9 @@ CDefFile::CDefFile(const AnimationPath & Name):
 
 	for (ui32 i=0; i<totalBlocks; i++)
 	{
-		size_t blockID = read_le_u32(data.get() + it);
+		size_t blockID = read_le_u32(data + it);
 		it+=4;
-		size_t totalEntries = read_le_u32(data.get() + it);
+		size_t totalEntries = read_le_u32(data + it);
 		it+=12;
 		//8 unknown bytes - skipping
 
@@ -74,7 +82,7 @@ CDefFile::CDefFile(const AnimationPath & Name):
 
 		for (ui32 j=0; j<totalEntries; j++)
 		{
-			size_t currOffset = read_le_u32(data.get() + it);
+			size_t currOffset = read_le_u32(data + it);
 			offset[blockID].push_back(currOffset);
 			it += 4;
 		}
@@ -87,7 +95,7 @@ void CDefFile::loadFrame(size_t frame, size_t group, IImageLoader &loader) const
 	it = offset.find(group);
 	assert (it != offset.end());
 
-	const ui8 * FDef = data.get()+it->second[frame];
+	const ui8 * FDef = data+it->second[frame];
 
 	const SSpriteDef sd = * reinterpret_cast<const SSpriteDef *>(FDef);
 	SSpriteDef sprite;
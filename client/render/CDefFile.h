@@ -12,6 +12,10 @@
 #include "../../lib/vcmi_endian.h"
 #include "../../lib/filesystem/ResourcePath.h"
 
+VCMI_LIB_NAMESPACE_BEGIN
+class CInputStream;
+VCMI_LIB_NAMESPACE_END
+
 class IImageLoader;
 struct SDL_Color;
 
@@ -36,7 +40,11 @@ private:
 	//offset[group][frame] - offset of frame data in file
 	std::map<size_t, std::vector <size_t> > offset;
 
-	std::unique_ptr<ui8[]>       data;
+	/// stream with file content, kept alive while file is accessed directly in memory
+	std::unique_ptr<CInputStream> stream;
+	/// copy of file content, used if stream does not allows direct access
+	std::unique_ptr<ui8[]>       buffer;
+	const ui8 *                  data;
 	std::unique_ptr<SDL_Color[]> palette;
 
 public:
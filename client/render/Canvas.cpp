@@ -139,6 +139,12 @@ void Canvas::drawScaled(const Canvas & image, const Point & pos, const Point & t
 	SDL_BlitScaled(image.surface, nullptr, surface, &targetRect);
 }
 
+void Canvas::copyScaled(const Canvas & image, const Point & pos, const Point & targetSize)
+{
+	Rect targetRect = Rect(transformPos(pos), transformSize(targetSize)).intersect(renderArea);
+	CSDL_Ext::copyScaledNearest(image.surface, image.renderArea, surface, targetRect);
+}
+
 void Canvas::drawPoint(const Point & dest, const ColorRGBA & color)
 {
 	Point point = transformPos(dest);
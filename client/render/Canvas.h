@@ -85,6 +85,10 @@ public:
 	/// renders another canvas onto this canvas with scaling
 	void drawScaled(const Canvas &image, const Point & pos, const Point & targetSize);
 
+	/// renders another canvas onto this canvas with nearest-neighbour scaling, same as drawScaled
+	/// does not modify state of any surface, so it can be used by multiple threads that draw into different areas
+	void copyScaled(const Canvas &image, const Point & pos, const Point & targetSize);
+
 	/// renders single pixels with specified color
 	void drawPoint(const Point & dest, const ColorRGBA & color);
 
@@ -40,4 +40,23 @@ public:
 
 	/// Loads animation using given path
 	virtual std::shared_ptr<CAnimation> loadAnimation(const AnimationPath & path, EImageBlitMode mode) = 0;
+
+	/// Packs images with specified locators into shared atlas surfaces, if atlases are enabled in settings
+	/// Images that are loaded afterwards will use pixel data from atlas. Returns true if any images were packed
+	virtual bool createAtlas(const std::vector<ImageLocator> & locators) = 0;
+
+	/// Starts loading and upscaling of specified images on background threads, so they will be ready once window requests them
+	virtual void prefetchImages(const std::vector<ImageLocator> & locators, EImageBlitMode mode) = 0;
+	virtual void prefetchAnimations(const std::vector<AnimationPath> & paths, EImageBlitMode mode) = 0;
+
+	/// Counter that is increased whenever image that was still being upscaled in background gets replaced with its final version
+	/// Can be used to detect that cached rendering results are outdated
+	virtual uint32_t getImagesVersion() const = 0;
+
+	/// Counter that is increased whenever image is drawn using placeholder because its final version is not ready yet
+	/// Can be used to detect which cached rendering results need to be rendered again once images version changes
+	virtual uint32_t getPlaceholderDrawsCount() const = 0;
+
+	/// Writes images that were upscaled in this session and are not stored yet into persistent cache, to be reused on next game start
+	virtual void saveScaledImages() = 0;
 };
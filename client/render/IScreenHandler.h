@@ -29,6 +29,18 @@ public:
 	/// Fills screen with black color, erasing any existing content
 	virtual void clearScreen() = 0;
 
+	/// Uploads parts of screen surface that were marked as modified since previous frame to screen texture
+	virtual void updateScreenTexture() = 0;
+
+	/// Renders screen texture to window, along with debug overlay of updated regions if enabled
+	virtual void presentScreenTexture() = 0;
+
+	/// Forces full upload of screen surface on next frame, e.g. after content of screen texture was lost
+	virtual void invalidateScreenTexture() = 0;
+
+	/// Marks area of screen, in logical coordinates, that was drawn to and needs to be uploaded on next frame
+	virtual void markDirty(const Rect & area) = 0;
+
 	/// Returns list of resolutions supported by current screen
 	virtual std::vector<Point> getSupportedResolutions() const = 0;
 
@@ -0,0 +1,149 @@
+/*
+ * AsyncSharedImage.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "AsyncSharedImage.h"
+
+#include "SDLImage.h"
+
+#include "../../lib/Point.h"
+
+std::atomic<uint32_t> AsyncSharedImage::placeholderDraws = 0;
+
+AsyncSharedImage::AsyncSharedImage(const std::shared_ptr<const ISharedImage> & placeholder)
+	: image(placeholder)
+{
+}
+
+AsyncSharedImage::AsyncSharedImage(const std::shared_ptr<const ISharedImage> & placeholder, const std::shared_ptr<const AsyncSharedImage> & source, const Transformation & transformation)
+	: image(placeholder)
+	, source(source)
+	, transformation(transformation)
+{
+}
+
+std::shared_ptr<const ISharedImage> AsyncSharedImage::getImage() const
+{
+	if (ready)
+		return image;
+
+	std::lock_guard lock(imageMutex);
+
+	// transformation is applied by first user of image, and not by background thread that finishes source image
+	if (source)
+	{
+		auto sourceImage = source->getFinalImage();
+		if (sourceImage)
+		{
+			image = transformation(*sourceImage);
+			ready = true;
+			source.reset();
+			transformation = nullptr;
+		}
+	}
+	return image;
+}
+
+std::shared_ptr<const ISharedImage> AsyncSharedImage::getFinalImage() const
+{
+	// may finish transformation of this image, if its source is ready
+	getImage();
+
+	// image is never modified once it is ready, so it can be returned without locking
+	return ready ? image : nullptr;
+}
+
+void AsyncSharedImage::setImage(const std::shared_ptr<const ISharedImage> & finalImage)
+{
+	std::lock_guard lock(imageMutex);
+	image = finalImage;
+	ready = true;
+}
+
+std::shared_ptr<ISharedImage> AsyncSharedImage::transform(const Transformation & transformation) const
+{
+	auto finalImage = getFinalImage();
+	if (finalImage)
+		return transformation(*finalImage);
+
+	return std::make_shared<AsyncSharedImage>(transformation(*getImage()), shared_from_this(), transformation);
+}
+
+void AsyncSharedImage::draw(SDL_Surface * where, SDL_Palette * palette, const Point & dest, const Rect * src, const ColorRGBA & colorMultiplier, uint8_t alpha, EImageBlitMode mode) const
+{
+	auto finalImage = getFinalImage();
+
+	if (finalImage)
+	{
+		finalImage->draw(where, palette, dest, src, colorMultiplier, alpha, mode);
+		return;
+	}
+
+	placeholderDraws++;
+	getImage()->draw(where, palette, dest, src, colorMultiplier, alpha, mode);
+}
+
+uint32_t AsyncSharedImage::getPlaceholderDrawsCount()
+{
+	return placeholderDraws;
+}
+
+void AsyncSharedImage::exportBitmap(const boost::filesystem::path & path, SDL_Palette * palette) const
+{
+	getImage()->exportBitmap(path, palette);
+}
+
+Point AsyncSharedImage::dimensions() const
+{
+	return getImage()->dimensions();
+}
+
+bool AsyncSharedImage::isTransparent(const Point & coords) const
+{
+	return getImage()->isTransparent(coords);
+}
+
+std::shared_ptr<IImage> AsyncSharedImage::createImageReference(EImageBlitMode mode)
+{
+	// both placeholder and final image are produced by scaling, which always results in 32-bit image
+	return std::make_shared<SDLImageRGB>(shared_from_this(), mode);
+}
+
+std::shared_ptr<ISharedImage> AsyncSharedImage::horizontalFlip() const
+{
+	return transform([](const ISharedImage & image)
+	{
+		return image.horizontalFlip();
+	});
+}
+
+std::shared_ptr<ISharedImage> AsyncSharedImage::verticalFlip() const
+{
+	return transform([](const ISharedImage & image)
+	{
+		return image.verticalFlip();
+	});
+}
+
+// both placeholder and final image are 32-bit images, so palette is not used by scaling and does not need to outlive this call
+std::shared_ptr<ISharedImage> AsyncSharedImage::scaleInteger(int factor, SDL_Palette * palette) const
+{
+	return transform([factor](const ISharedImage & image)
+	{
+		return image.scaleInteger(factor, nullptr);
+	});
+}
+
+std::shared_ptr<ISharedImage> AsyncSharedImage::scaleTo(const Point & size, SDL_Palette * palette) const
+{
+	return transform([size](const ISharedImage & image)
+	{
+		return image.scaleTo(size, nullptr);
+	});
+}
@@ -0,0 +1,59 @@
+/*
+ * AsyncSharedImage.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../render/IImage.h"
+
+/// Image that is still being processed on background thread
+/// Until processing is over, all calls are forwarded to placeholder image of same size, e.g. image upscaled with faster algorithm
+/// Once final image is ready, it replaces placeholder for all users of this image
+/// Images transformed from placeholder are asynchronous as well and apply same transformation to final image once it is ready
+class AsyncSharedImage final : public ISharedImage, public std::enable_shared_from_this<AsyncSharedImage>, boost::noncopyable
+{
+	using Transformation = std::function<std::shared_ptr<ISharedImage>(const ISharedImage &)>;
+
+	mutable std::shared_ptr<const ISharedImage> image;
+	/// image from which this image was transformed, reset once transformation of its final image is done
+	mutable std::shared_ptr<const AsyncSharedImage> source;
+	mutable Transformation transformation;
+	/// set once final image is available, after which image is never modified and can be read without locking
+	mutable std::atomic<bool> ready = false;
+	mutable std::mutex imageMutex;
+
+	std::shared_ptr<const ISharedImage> getImage() const;
+
+	/// returns final image, or nullptr if it is not ready yet
+	std::shared_ptr<const ISharedImage> getFinalImage() const;
+
+	std::shared_ptr<ISharedImage> transform(const Transformation & transformation) const;
+
+	static std::atomic<uint32_t> placeholderDraws;
+
+public:
+	/// Number of draw calls so far that used placeholder instead of final image
+	static uint32_t getPlaceholderDrawsCount();
+
+	explicit AsyncSharedImage(const std::shared_ptr<const ISharedImage> & placeholder);
+	AsyncSharedImage(const std::shared_ptr<const ISharedImage> & placeholder, const std::shared_ptr<const AsyncSharedImage> & source, const Transformation & transformation);
+
+	/// Replaces placeholder with final image. May be called from any thread
+	void setImage(const std::shared_ptr<const ISharedImage> & finalImage);
+
+	void draw(SDL_Surface * where, SDL_Palette * palette, const Point & dest, const Rect * src, const ColorRGBA & colorMultiplier, uint8_t alpha, EImageBlitMode mode) const override;
+
+	void exportBitmap(const boost::filesystem::path & path, SDL_Palette * palette) const override;
+	Point dimensions() const override;
+	bool isTransparent(const Point & coords) const override;
+	std::shared_ptr<IImage> createImageReference(EImageBlitMode mode) override;
+	std::shared_ptr<ISharedImage> horizontalFlip() const override;
+	std::shared_ptr<ISharedImage> verticalFlip() const override;
+	std::shared_ptr<ISharedImage> scaleInteger(int factor, SDL_Palette * palette) const override;
+	std::shared_ptr<ISharedImage> scaleTo(const Point & size, SDL_Palette * palette) const override;
+};
@@ -21,6 +21,10 @@
 
 #include <SDL_ttf.h>
 
+// limits of rendered text cache, per font. Oldest entries are evicted once any of limits is reached
+static constexpr size_t textRunsMaxEntries = 1024;
+static constexpr size_t textRunsMaxBytes = 8 * 1024 * 1024;
+
 std::pair<std::unique_ptr<ui8[]>, ui64> CTrueTypeFont::loadData(const JsonNode & config)
 {
 	std::string filename = "Data/" + config["file"].String();
@@ -116,16 +120,57 @@ void CTrueTypeFont::renderText(SDL_Surface * surface, const std::string & data,
 
 	if (!data.empty())
 	{
-		SDL_Surface * rendered;
-		if (blended)
-			rendered = TTF_RenderUTF8_Blended(font.get(), data.c_str(), CSDL_Ext::toSDL(color));
-		else
-			rendered = TTF_RenderUTF8_Solid(font.get(), data.c_str(), CSDL_Ext::toSDL(color));
+		SDL_Surface * rendered = getTextRun(data, color);
 
 		assert(rendered);
 
-		CSDL_Ext::blitSurface(rendered, surface, pos);
-		SDL_FreeSurface(rendered);
+		if (rendered)
+			CSDL_Ext::blitSurface(rendered, surface, pos);
+	}
+}
+
+SDL_Surface * CTrueTypeFont::getTextRun(const std::string & data, const ColorRGBA & color) const
+{
+	TextRunKey key(data, (color.r << 24) | (color.g << 16) | (color.b << 8) | color.a);
+
+	auto it = textRunsIndex.find(key);
+	if (it != textRunsIndex.end())
+	{
+		statistics.hits++;
+		textRuns.splice(textRuns.begin(), textRuns, it->second);
+		return it->second->surface.get();
 	}
+
+	statistics.misses++;
+
+	SDL_Surface * rendered;
+	if (blended)
+		rendered = TTF_RenderUTF8_Blended(font.get(), data.c_str(), CSDL_Ext::toSDL(color));
+	else
+		rendered = TTF_RenderUTF8_Solid(font.get(), data.c_str(), CSDL_Ext::toSDL(color));
+
+	if (!rendered)
+		return nullptr;
+
+	textRuns.push_front({key, {rendered, SDL_FreeSurface}});
+	textRunsIndex[key] = textRuns.begin();
+	statistics.entries++;
+	statistics.bytes += rendered->pitch * rendered->h;
+
+	while (textRuns.size() > 1 && (statistics.entries > textRunsMaxEntries || statistics.bytes > textRunsMaxBytes))
+	{
+		const auto & oldest = textRuns.back();
+		statistics.entries--;
+		statistics.bytes -= oldest.surface->pitch * oldest.surface->h;
+		textRunsIndex.erase(oldest.key);
+		textRuns.pop_back();
+	}
+
+	return rendered;
+}
+
+CTrueTypeFont::CacheStatistics CTrueTypeFont::getCacheStatistics() const
+{
+	return statistics;
 }
 
@@ -21,6 +21,31 @@ using TTF_Font = struct _TTF_Font;
 
 class CTrueTypeFont final : public IFont
 {
+public:
+	struct CacheStatistics
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		size_t entries = 0;
+		size_t bytes = 0;
+	};
+
+private:
+	/// text and its color
+	using TextRunKey = std::pair<std::string, uint32_t>;
+
+	/// Rendered text, kept until evicted by more recently used text
+	struct TextRun
+	{
+		TextRunKey key;
+		std::unique_ptr<SDL_Surface, void (*)(SDL_Surface*)> surface;
+	};
+
+	/// Most recently used text runs are in front of the list
+	mutable std::list<TextRun> textRuns;
+	mutable std::map<TextRunKey, std::list<TextRun>::iterator> textRunsIndex;
+	mutable CacheStatistics statistics;
+
 	std::unique_ptr<CBitmapFont> fallbackFont;
 	const std::pair<std::unique_ptr<ui8[]>, ui64> data;
 
@@ -33,6 +58,8 @@ class CTrueTypeFont final : public IFont
 	int getPointSize(const JsonNode & config) const;
 	int getFontStyle(const JsonNode & config) const;
 
+	SDL_Surface * getTextRun(const std::string & data, const ColorRGBA & color) const;
+
 	void renderText(SDL_Surface * surface, const std::string & data, const ColorRGBA & color, const Point & pos) const override;
 public:
 	CTrueTypeFont(const JsonNode & fontConfig);
@@ -41,4 +68,7 @@ public:
 	size_t getLineHeight() const override;
 	size_t getGlyphWidth(const char * data) const override;
 	size_t getStringWidth(const std::string & data) const override;
+
+	/// Returns usage statistics of cache of rendered text
+	CacheStatistics getCacheStatistics() const;
 };
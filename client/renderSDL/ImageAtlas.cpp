@@ -0,0 +1,138 @@
+/*
+ * ImageAtlas.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "ImageAtlas.h"
+
+#include "SDLImage.h"
+
+#include <SDL_surface.h>
+
+// larger images are stored as they are
+static constexpr int maximalAtlasWidth = 2048;
+
+std::vector<std::shared_ptr<ISharedImage>> ImageAtlas::pack(const std::vector<std::shared_ptr<ISharedImage>> & images, Statistics & statistics)
+{
+	std::vector<std::shared_ptr<ISharedImage>> result = images;
+	std::map<uint32_t, std::vector<size_t>> imagesByFormat;
+
+	for(size_t i = 0; i < images.size(); ++i)
+	{
+		const auto * image = dynamic_cast<const SDLImageShared *>(images[i].get());
+
+		if(image && image->surf && !image->atlas && image->surf->w <= maximalAtlasWidth)
+			imagesByFormat[image->surf->format->format].push_back(i);
+	}
+
+	for(auto & [format, indices] : imagesByFormat)
+	{
+		if(indices.size() < 2)
+			continue;
+
+		auto surfaceOf = [&images](size_t index)
+		{
+			return dynamic_cast<const SDLImageShared &>(*images[index]).surf;
+		};
+
+		// shelf packing - place images row by row, starting from the tallest ones
+		std::sort(indices.begin(), indices.end(), [&surfaceOf](size_t left, size_t right)
+		{
+			return std::make_pair(surfaceOf(left)->h, surfaceOf(left)->w) > std::make_pair(surfaceOf(right)->h, surfaceOf(right)->w);
+		});
+
+		int64_t totalArea = 0;
+		int widestImage = 0;
+		for(size_t index : indices)
+		{
+			totalArea += surfaceOf(index)->w * surfaceOf(index)->h;
+			widestImage = std::max(widestImage, surfaceOf(index)->w);
+		}
+
+		int atlasWidth = 64;
+		while(atlasWidth < maximalAtlasWidth && int64_t(atlasWidth) * atlasWidth < totalArea)
+			atlasWidth *= 2;
+		atlasWidth = std::max(atlasWidth, widestImage);
+
+		std::vector<Point> positions(indices.size());
+		Point shelfPosition(0, 0);
+		int shelfHeight = 0;
+
+		for(size_t i = 0; i < indices.size(); ++i)
+		{
+			const SDL_Surface * surf = surfaceOf(indices[i]);
+
+			if(shelfPosition.x + surf->w > atlasWidth)
+			{
+				shelfPosition = Point(0, shelfPosition.y + shelfHeight);
+				shelfHeight = 0;
+			}
+
+			positions[i] = shelfPosition;
+			shelfPosition.x += surf->w;
+			shelfHeight = std::max(shelfHeight, surf->h);
+		}
+
+		int atlasHeight = shelfPosition.y + shelfHeight;
+		int bitsPerPixel = surfaceOf(indices.front())->format->BitsPerPixel;
+
+		SDL_Surface * atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, bitsPerPixel, format);
+		if(!atlasSurface)
+		{
+			logGlobal->warn("Failed to create image atlas of size %dx%d: %s", atlasWidth, atlasHeight, SDL_GetError());
+			continue;
+		}
+
+		std::shared_ptr<SDL_Surface> atlas(atlasSurface, SDL_FreeSurface);
+		int bytesPerPixel = atlas->format->BytesPerPixel;
+
+		for(size_t i = 0; i < indices.size(); ++i)
+		{
+			const auto & source = dynamic_cast<const SDLImageShared &>(*images[indices[i]]);
+			SDL_Surface * surf = source.surf;
+			auto * pixels = static_cast<uint8_t *>(atlas->pixels) + positions[i].y * atlas->pitch + positions[i].x * bytesPerPixel;
+
+			for(int y = 0; y < surf->h; ++y)
+				std::memcpy(pixels + y * atlas->pitch, static_cast<const uint8_t *>(surf->pixels) + y * surf->pitch, surf->w * bytesPerPixel);
+
+			// surface that uses atlas memory as its pixel data, with own palette and color key
+			SDL_Surface * view = SDL_CreateRGBSurfaceWithFormatFrom(pixels, surf->w, surf->h, bitsPerPixel, atlas->pitch, format);
+
+			if(surf->format->palette)
+			{
+				SDL_Palette * palette = source.originalPalette ? source.originalPalette : surf->format->palette;
+				SDL_SetPaletteColors(view->format->palette, palette->colors, 0, std::min(palette->ncolors, view->format->palette->ncolors));
+			}
+
+			uint32_t colorKey;
+			if(SDL_GetColorKey(surf, &colorKey) == 0)
+				SDL_SetColorKey(view, SDL_TRUE, colorKey);
+
+			SDL_BlendMode blendMode;
+			SDL_GetSurfaceBlendMode(surf, &blendMode);
+			SDL_SetSurfaceBlendMode(view, blendMode);
+
+			auto packed = std::make_shared<SDLImageShared>(view);
+			packed->margins = source.margins;
+			packed->fullSize = source.fullSize;
+			packed->atlas = atlas;
+
+			// erase our own reference
+			SDL_FreeSurface(view);
+
+			statistics.imageBytes += surf->pitch * surf->h;
+			result[indices[i]] = packed;
+		}
+
+		statistics.atlases += 1;
+		statistics.images += indices.size();
+		statistics.atlasBytes += atlas->pitch * atlas->h;
+	}
+
+	return result;
+}
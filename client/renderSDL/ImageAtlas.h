@@ -0,0 +1,32 @@
+/*
+ * ImageAtlas.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+class ISharedImage;
+
+/// Packs multiple images into shared surfaces, to reduce number of allocations and keep pixel data of related images close in memory
+/// Packed images are regular images that use sub-rectangle of atlas surface as their pixel data
+class ImageAtlas
+{
+public:
+	struct Statistics
+	{
+		size_t atlases = 0;
+		size_t images = 0;
+		/// memory used by pixel data of all atlases
+		size_t atlasBytes = 0;
+		/// memory that would be used by pixel data of packed images without atlases
+		size_t imageBytes = 0;
+	};
+
+	/// Returns packed versions of input images, in same order. Images that can not be packed are returned as they are
+	/// Images are grouped into separate atlases by their pixel format
+	static std::vector<std::shared_ptr<ISharedImage>> pack(const std::vector<std::shared_ptr<ISharedImage>> & images, Statistics & statistics);
+};
@@ -10,10 +10,13 @@
 #include "StdInc.h"
 #include "RenderHandler.h"
 
+#include "AsyncSharedImage.h"
 #include "SDLImage.h"
 #include "ImageScaled.h"
+#include "ScaledImageCache.h"
 
 #include "../gui/CGuiHandler.h"
+#include "../gui/WindowHandler.h"
 
 #include "../render/CAnimation.h"
 #include "../render/CDefFile.h"
@@ -21,6 +24,7 @@
 #include "../render/ColorFilter.h"
 #include "../render/IScreenHandler.h"
 
+#include "../../lib/CConfigHandler.h"
 #include "../../lib/json/JsonUtils.h"
 #include "../../lib/filesystem/Filesystem.h"
 #include "../../lib/VCMIDirs.h"
@@ -34,6 +38,15 @@
 #include <vcmi/SkillService.h>
 #include <vcmi/spells/Service.h>
 
+RenderHandler::RenderHandler() = default;
+
+RenderHandler::~RenderHandler() noexcept
+{
+	// images that are not upscaled yet are not needed anymore
+	workers.cancel();
+	workers.wait();
+}
+
 std::shared_ptr<CDefFile> RenderHandler::getAnimationFile(const AnimationPath & path)
 {
 	AnimationPath actualPath = boost::starts_with(path.getName(), "SPRITES") ? path : path.addPrefix("SPRITES/");
@@ -155,9 +168,9 @@ ImageLocator RenderHandler::getLocatorForAnimationFrame(const AnimationPath & pa
 
 std::shared_ptr<ISharedImage> RenderHandler::loadImageImpl(const ImageLocator & locator)
 {
-	auto it = imageFiles.find(locator);
-	if (it != imageFiles.end())
-		return it->second;
+	auto cachedImage = findCachedImage(locator);
+	if (cachedImage)
+		return cachedImage;
 
 	// TODO: order should be different:
 	// 1) try to find correctly scaled image
@@ -189,9 +202,24 @@ std::shared_ptr<ISharedImage> RenderHandler::loadImageFromFileUncached(const Ima
 	throw std::runtime_error("Invalid image locator received!");
 }
 
-void RenderHandler::storeCachedImage(const ImageLocator & locator, std::shared_ptr<ISharedImage> image)
+std::shared_ptr<ISharedImage> RenderHandler::findCachedImage(const ImageLocator & locator)
 {
-	imageFiles[locator] = image;
+	std::lock_guard lock(imageFilesMutex);
+
+	auto it = imageFiles.find(locator);
+	if (it != imageFiles.end())
+		return it->second;
+	return nullptr;
+}
+
+std::shared_ptr<ISharedImage> RenderHandler::storeCachedImage(const ImageLocator & locator, std::shared_ptr<ISharedImage> image)
+{
+	std::lock_guard lock(imageFilesMutex);
+
+	// image might have been loaded by background thread in meantime
+	auto result = imageFiles.emplace(locator, image);
+	if (!result.second)
+		return result.first->second;
 
 #if 0
 	const boost::filesystem::path outPath = VCMIDirs::get().userExtractedPath() / "imageCache" / (locator.toString() + ".png");
@@ -200,22 +228,23 @@ void RenderHandler::storeCachedImage(const ImageLocator & locator, std::shared_p
 	boost::filesystem::create_directories(outDir);
 	image->exportBitmap(outPath , nullptr);
 #endif
+	return image;
 }
 
 std::shared_ptr<ISharedImage> RenderHandler::loadImageFromFile(const ImageLocator & locator)
 {
-	if (imageFiles.count(locator))
-		return imageFiles.at(locator);
+	auto cachedImage = findCachedImage(locator);
+	if (cachedImage)
+		return cachedImage;
 
-	auto result = loadImageFromFileUncached(locator);
-	storeCachedImage(locator, result);
-	return result;
+	return storeCachedImage(locator, loadImageFromFileUncached(locator));
 }
 
 std::shared_ptr<ISharedImage> RenderHandler::transformImage(const ImageLocator & locator, std::shared_ptr<ISharedImage> image)
 {
-	if (imageFiles.count(locator))
-		return imageFiles.at(locator);
+	auto cachedImage = findCachedImage(locator);
+	if (cachedImage)
+		return cachedImage;
 
 	auto result = image;
 
@@ -225,19 +254,22 @@ std::shared_ptr<ISharedImage> RenderHandler::transformImage(const ImageLocator &
 	if (locator.horizontalFlip)
 		result = result->horizontalFlip();
 
-	storeCachedImage(locator, result);
-	return result;
+	return storeCachedImage(locator, result);
 }
 
-std::shared_ptr<ISharedImage> RenderHandler::scaleImage(const ImageLocator & locator, std::shared_ptr<ISharedImage> image)
+ScaledImageCache & RenderHandler::getScaledImageCache()
 {
-	if (imageFiles.count(locator))
-		return imageFiles.at(locator);
+	std::call_once(scaledImageCacheFlag, [this]()
+	{
+		scaledImageCache = std::make_unique<ScaledImageCache>();
+	});
+	return *scaledImageCache;
+}
 
+std::shared_ptr<IImage> RenderHandler::createScalingHandle(const ImageLocator & locator, const std::shared_ptr<ISharedImage> & image)
+{
 	auto handle = image->createImageReference(locator.layer == EImageLayer::ALL ? EImageBlitMode::OPAQUE : EImageBlitMode::ALPHA);
 
-	assert(locator.scalingFactor != 1); // should be filtered-out before
-
 	handle->setBodyEnabled(locator.layer == EImageLayer::ALL || locator.layer == EImageLayer::BODY);
 	if (locator.layer != EImageLayer::ALL)
 	{
@@ -247,14 +279,95 @@ std::shared_ptr<ISharedImage> RenderHandler::scaleImage(const ImageLocator & loc
 	if (locator.layer == EImageLayer::ALL && locator.playerColored != PlayerColor::CANNOT_DETERMINE)
 		handle->playerColored(locator.playerColored);
 
+	return handle;
+}
+
+std::shared_ptr<ISharedImage> RenderHandler::scaleImageUncached(const ImageLocator & locator, const std::shared_ptr<ISharedImage> & image)
+{
+	auto handle = createScalingHandle(locator, image);
+
 	handle->scaleInteger(locator.scalingFactor);
 
 	// TODO: try to optimize image size (possibly even before scaling?) - trim image borders if they are completely transparent
 	auto result = handle->getSharedImage();
-	storeCachedImage(locator, result);
+	if (result)
+		getScaledImageCache().store(locator, *image, *result);
 	return result;
 }
 
+std::shared_ptr<ISharedImage> RenderHandler::scaleImage(const ImageLocator & locator, std::shared_ptr<ISharedImage> image)
+{
+	auto cachedImage = findCachedImage(locator);
+	if (cachedImage)
+		return cachedImage;
+
+	assert(locator.scalingFactor != 1); // should be filtered-out before
+
+	auto storedImage = getScaledImageCache().load(locator, *image);
+	if (storedImage)
+		return storeCachedImage(locator, storedImage);
+
+	if (!settings["video"]["asyncUpscaling"].Bool())
+		return storeCachedImage(locator, scaleImageUncached(locator, image));
+
+	// xBRZ upscaling is slow, so use bilinear upscaling as placeholder and replace it once upscaling in background is over
+	auto placeholder = createScalingHandle(locator, image);
+	placeholder->scaleTo(image->dimensions() * locator.scalingFactor);
+
+	auto asyncImage = std::make_shared<AsyncSharedImage>(placeholder->getSharedImage());
+	auto result = storeCachedImage(locator, asyncImage);
+
+	if (result == asyncImage)
+	{
+		workers.run([this, locator, image, asyncImage]()
+		{
+			auto finalImage = scaleImageUncached(locator, image);
+			asyncImage->setImage(finalImage);
+			onAsyncImageReady(locator, asyncImage, finalImage);
+		});
+	}
+	return result;
+}
+
+void RenderHandler::onAsyncImageReady(const ImageLocator & locator, const std::shared_ptr<ISharedImage> & asyncImage, const std::shared_ptr<ISharedImage> & finalImage)
+{
+	{
+		std::lock_guard lock(imageFilesMutex);
+
+		// image might have been replaced in meantime, e.g. by packing into atlas
+		auto it = imageFiles.find(locator);
+		if (it != imageFiles.end() && it->second == asyncImage)
+			it->second = finalImage;
+	}
+
+	// coalesce redraw requests from all images that were upscaled before main thread got to them
+	// so cached rendering results are invalidated at most once per frame
+	if (asyncState->redrawRequested.exchange(true))
+		return;
+
+	std::weak_ptr<AsyncUpscalingState> weakState = asyncState;
+	GH.dispatchMainThread([weakState]()
+	{
+		auto state = weakState.lock();
+		if (!state)
+			return;
+
+		state->redrawRequested = false;
+		state->imagesVersion++;
+		GH.windows().totalRedraw();
+	});
+}
+
+uint32_t RenderHandler::getImagesVersion() const
+{
+	return asyncState->imagesVersion;
+}
+
+uint32_t RenderHandler::getPlaceholderDrawsCount() const
+{
+	return AsyncSharedImage::getPlaceholderDrawsCount();
+}
+
 std::shared_ptr<IImage> RenderHandler::loadImage(const ImageLocator & locator, EImageBlitMode mode)
 {
 	if (locator.scalingFactor == 0 && getScalingFactor() != 1 )
@@ -304,6 +417,159 @@ std::shared_ptr<CAnimation> RenderHandler::loadAnimation(const AnimationPath & p
 	return std::make_shared<CAnimation>(path, getAnimationLayout(path), mode);
 }
 
+bool RenderHandler::createAtlas(const std::vector<ImageLocator> & locators)
+{
+	if (!settings["video"]["imageAtlas"].Bool())
+		return false;
+
+	std::set<ImageLocator> processedLocators;
+	std::vector<ImageLocator> packedLocators;
+	std::vector<std::shared_ptr<ISharedImage>> images;
+
+	for (const auto & locator : locators)
+	{
+		if (locator.empty())
+			continue;
+
+		// atlas contains images after transformations but before scaling, same image may be referenced several times
+		auto transformLocator = locator.copyFileTransform();
+		if (!processedLocators.insert(transformLocator).second)
+			continue;
+
+		packedLocators.push_back(transformLocator);
+		images.push_back(transformImage(transformLocator, loadImageFromFile(locator.copyFile())));
+	}
+
+	ImageAtlas::Statistics statistics;
+	auto packedImages = ImageAtlas::pack(images, statistics);
+
+	if (statistics.atlases == 0)
+		return false;
+
+	{
+		std::lock_guard lock(imageFilesMutex);
+		for (size_t i = 0; i < packedLocators.size(); ++i)
+			imageFiles[packedLocators[i]] = packedImages[i];
+	}
+
+	atlasStatistics.atlases += statistics.atlases;
+	atlasStatistics.images += statistics.images;
+	atlasStatistics.atlasBytes += statistics.atlasBytes;
+	atlasStatistics.imageBytes += statistics.imageBytes;
+
+	logGlobal->debug("Packed %d images into %d KB atlas (%d KB as separate images). Total: %d images in %d atlases, %d KB (%d KB as separate images)",
+		statistics.images, statistics.atlasBytes / 1024, statistics.imageBytes / 1024,
+		atlasStatistics.images, atlasStatistics.atlases, atlasStatistics.atlasBytes / 1024, atlasStatistics.imageBytes / 1024);
+
+	return true;
+}
+
+void RenderHandler::prefetchImage(const ImageLocator & locator, const std::shared_ptr<CDefFile> & defFile, EImageBlitMode mode, int scalingFactor)
+{
+	ImageLocator fileLocator = locator.copyFile();
+
+	auto image = findCachedImage(fileLocator);
+	if (!image)
+	{
+		if (fileLocator.defFile)
+			image = std::make_shared<SDLImageShared>(defFile.get(), fileLocator.defFrame, fileLocator.defGroup);
+		else
+			image = std::make_shared<SDLImageShared>(*fileLocator.image);
+
+		image = storeCachedImage(fileLocator, image);
+	}
+
+	// flipping is not thread-safe, such images will be upscaled once requested
+	if (scalingFactor == 1 || locator.verticalFlip || locator.horizontalFlip)
+		return;
+
+	// same layers as the ones that will be requested by ImageScaled
+	std::vector<EImageLayer> layers;
+	if (mode == EImageBlitMode::ALPHA)
+		layers = { EImageLayer::BODY, EImageLayer::SHADOW };
+	else
+		layers = { EImageLayer::ALL };
+
+	for (auto layer : layers)
+	{
+		ImageLocator scaledLocator = locator;
+		scaledLocator.scalingFactor = scalingFactor;
+		scaledLocator.layer = layer;
+		scaledLocator.playerColored = PlayerColor::CANNOT_DETERMINE;
+
+		if (findCachedImage(scaledLocator))
+			continue;
+
+		auto scaledImage = getScaledImageCache().load(scaledLocator, *image);
+		if (!scaledImage)
+			scaledImage = scaleImageUncached(scaledLocator, image);
+
+		storeCachedImage(scaledLocator, scaledImage);
+	}
+}
+
+void RenderHandler::prefetchImages(const std::vector<ImageLocator> & locators, EImageBlitMode mode)
+{
+	int scalingFactor = getScalingFactor();
+
+	for (const auto & locator : locators)
+	{
+		if (locator.empty() || locator.scalingFactor != 0)
+			continue;
+
+		// animation files are not thread-safe, so they must be opened before passing to background thread
+		std::shared_ptr<CDefFile> defFile;
+		if (locator.defFile)
+		{
+			defFile = getAnimationFile(*locator.defFile);
+			if (!defFile)
+				continue;
+		}
+
+		workers.run([this, locator, defFile, mode, scalingFactor]()
+		{
+			try
+			{
+				prefetchImage(locator, defFile, mode, scalingFactor);
+			}
+			catch (const std::exception & e)
+			{
+				logGlobal->warn("Failed to prefetch image %s: %s", locator.toString(), e.what());
+			}
+		});
+	}
+}
+
+void RenderHandler::prefetchAnimations(const std::vector<AnimationPath> & paths, EImageBlitMode mode)
+{
+	// read and unpack only files that are not opened yet - opened files are kept in memory anyway
+	std::vector<AnimationPath> filesToLoad;
+	for (const auto & path : paths)
+	{
+		AnimationPath actualPath = boost::starts_with(path.getName(), "SPRITES") ? path : path.addPrefix("SPRITES/");
+		if (!animationFiles.count(actualPath) && !vstd::contains(filesToLoad, actualPath))
+			filesToLoad.push_back(actualPath);
+	}
+	CResourceHandler::get()->prefetch(std::vector<ResourcePath>(filesToLoad.begin(), filesToLoad.end()));
+
+	// open all prefetched files right away, so no unpacked data is left behind in filesystem
+	for (const auto & path : filesToLoad)
+		getAnimationFile(path);
+
+	std::vector<ImageLocator> locators;
+	for (const auto & path : paths)
+		for (const auto & group : getAnimationLayout(path))
+			for (size_t frame = 0; frame < group.second.size(); ++frame)
+				locators.push_back(getLocatorForAnimationFrame(path, frame, group.first));
+
+	prefetchImages(locators, mode);
+}
+
+void RenderHandler::saveScaledImages()
+{
+	getScaledImageCache().save();
+}
+
 void RenderHandler::addImageListEntries(const EntityService * service)
 {
 	service->forEachBase([this](const Entity * entity, bool & stop)
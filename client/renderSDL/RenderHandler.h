@@ -9,8 +9,12 @@
  */
 #pragma once
 
+#include "ImageAtlas.h"
+
 #include "../render/IRenderHandler.h"
 
+#include <tbb/task_group.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 class EntityService;
 VCMI_LIB_NAMESPACE_END
@@ -18,6 +22,7 @@ VCMI_LIB_NAMESPACE_END
 class CDefFile;
 class SDLImageShared;
 class ISharedImage;
+class ScaledImageCache;
 
 class RenderHandler : public IRenderHandler
 {
@@ -26,6 +31,25 @@ class RenderHandler : public IRenderHandler
 	std::map<AnimationPath, std::shared_ptr<CDefFile>> animationFiles;
 	std::map<AnimationPath, AnimationLayoutMap> animationLayouts;
 	std::map<ImageLocator, std::shared_ptr<ISharedImage>> imageFiles;
+	/// Protects imageFiles, which is also filled by background threads
+	std::mutex imageFilesMutex;
+
+	std::unique_ptr<ScaledImageCache> scaledImageCache;
+	std::once_flag scaledImageCacheFlag;
+
+	/// State of background upscaling that is shared with callbacks dispatched to main thread
+	struct AsyncUpscalingState
+	{
+		std::atomic<uint32_t> imagesVersion = 0;
+		std::atomic<bool> redrawRequested = false;
+	};
+
+	/// Background threads for image upscaling and prefetching
+	tbb::task_group workers;
+	/// Main thread callbacks only hold weak reference to this state, since they may be executed after render handler is destroyed
+	std::shared_ptr<AsyncUpscalingState> asyncState = std::make_shared<AsyncUpscalingState>();
+
+	ImageAtlas::Statistics atlasStatistics;
 
 	std::shared_ptr<CDefFile> getAnimationFile(const AnimationPath & path);
 	AnimationLayoutMap & getAnimationLayout(const AnimationPath & path);
@@ -33,7 +57,9 @@ class RenderHandler : public IRenderHandler
 
 	void addImageListEntry(size_t index, size_t group, const std::string & listName, const std::string & imageName);
 	void addImageListEntries(const EntityService * service);
-	void storeCachedImage(const ImageLocator & locator, std::shared_ptr<ISharedImage> image);
+	std::shared_ptr<ISharedImage> findCachedImage(const ImageLocator & locator);
+	/// Stores image in cache, unless another image with same locator was stored before. Returns image that is now in cache
+	std::shared_ptr<ISharedImage> storeCachedImage(const ImageLocator & locator, std::shared_ptr<ISharedImage> image);
 
 	std::shared_ptr<ISharedImage> loadImageImpl(const ImageLocator & config);
 
@@ -43,11 +69,22 @@ class RenderHandler : public IRenderHandler
 	std::shared_ptr<ISharedImage> transformImage(const ImageLocator & locator, std::shared_ptr<ISharedImage> image);
 	std::shared_ptr<ISharedImage> scaleImage(const ImageLocator & locator, std::shared_ptr<ISharedImage> image);
 
+	/// Upscales image with xBRZ and stores result in persistent cache. Thread-safe, does not touch imageFiles
+	std::shared_ptr<ISharedImage> scaleImageUncached(const ImageLocator & locator, const std::shared_ptr<ISharedImage> & image);
+	std::shared_ptr<IImage> createScalingHandle(const ImageLocator & locator, const std::shared_ptr<ISharedImage> & image);
+	ScaledImageCache & getScaledImageCache();
+
+	void prefetchImage(const ImageLocator & locator, const std::shared_ptr<CDefFile> & defFile, EImageBlitMode mode, int scalingFactor);
+	/// Replaces asynchronous image in cache with its final image, so new users of image no longer go through placeholder
+	void onAsyncImageReady(const ImageLocator & locator, const std::shared_ptr<ISharedImage> & asyncImage, const std::shared_ptr<ISharedImage> & finalImage);
+
 	ImageLocator getLocatorForAnimationFrame(const AnimationPath & path, int frame, int group);
 
 	int getScalingFactor() const;
 
 public:
+	RenderHandler();
+	~RenderHandler() noexcept;
 
 	// IRenderHandler implementation
 	void onLibraryLoadingFinished(const Services * services) override;
@@ -58,5 +95,13 @@ public:
 
 	std::shared_ptr<CAnimation> loadAnimation(const AnimationPath & path, EImageBlitMode mode) override;
 
+	bool createAtlas(const std::vector<ImageLocator> & locators) override;
+	void prefetchImages(const std::vector<ImageLocator> & locators, EImageBlitMode mode) override;
+	void prefetchAnimations(const std::vector<AnimationPath> & paths, EImageBlitMode mode) override;
+	uint32_t getImagesVersion() const override;
+	uint32_t getPlaceholderDrawsCount() const override;
+
+	void saveScaledImages() override;
+
 	std::shared_ptr<IImage> createImage(SDL_Surface * source) override;
 };
@@ -166,6 +166,43 @@ void SDLImageShared::draw(SDL_Surface * where, SDL_Palette * palette, const Poin
 
 	destShift += dest;
 
+	const int targetBpp = where->format->BytesPerPixel;
+	if (surf->format->palette && (targetBpp == 3 || targetBpp == 4))
+	{
+		// Palette of image is used as indirection table of the blitter, so player colors, palette cycling and color filters
+		// don't need to modify shared surface, which would also force SDL to rebuild its blit mapping on every draw
+		std::array<SDL_Color, 256> colors = {};
+		const SDL_Palette * sourcePalette = palette ? palette : surf->format->palette;
+		std::copy_n(sourcePalette->colors, std::min(sourcePalette->ncolors, 256), colors.begin());
+
+		if (mode != EImageBlitMode::ALPHA)
+		{
+			// Same as SDL blit of indexed surface: palette alpha is ignored, only color key (if any) is transparent
+			uint32_t colorKey = 0;
+			bool hasColorKey = SDL_GetColorKey(surf, &colorKey) == 0;
+
+			for (auto & color : colors)
+				color.a = SDL_ALPHA_OPAQUE;
+			if (hasColorKey && colorKey < colors.size())
+				colors[colorKey].a = SDL_ALPHA_TRANSPARENT;
+		}
+
+		// SDL applies color modulation when mapping palette of indexed surface, but alpha blitter never did,
+		// so images drawn with alpha blending of palette keep ignoring color multiplier
+		if (mode != EImageBlitMode::ALPHA && !(colorMultiplier == Colors::WHITE_TRUE))
+		{
+			for (auto & color : colors)
+			{
+				color.r = color.r * colorMultiplier.r / 255;
+				color.g = color.g * colorMultiplier.g / 255;
+				color.b = color.b * colorMultiplier.b / 255;
+			}
+		}
+
+		CSDL_Ext::blit8bppAlphaTo24bpp(surf, sourceRect, where, destShift, alpha, colors.data());
+		return;
+	}
+
 	SDL_SetSurfaceColorMod(surf, colorMultiplier.r, colorMultiplier.g, colorMultiplier.b);
 	SDL_SetSurfaceAlphaMod(surf, alpha);
 
@@ -177,14 +214,7 @@ void SDLImageShared::draw(SDL_Surface * where, SDL_Palette * palette, const Poin
 	if (palette && surf->format->palette)
 		SDL_SetSurfacePalette(surf, palette);
 
-	if(surf->format->palette && mode == EImageBlitMode::ALPHA)
-	{
-		CSDL_Ext::blit8bppAlphaTo24bpp(surf, sourceRect, where, destShift, alpha);
-	}
-	else
-	{
-		CSDL_Ext::blitSurface(surf, sourceRect, where, destShift);
-	}
+	CSDL_Ext::blitSurface(surf, sourceRect, where, destShift);
 
 	if (surf->format->palette)
 		SDL_SetSurfacePalette(surf, originalPalette);
@@ -266,15 +296,33 @@ void SDLImageShared::optimizeSurface()
 	}
 }
 
+SDL_Surface * SDLImageShared::createSurfaceView(SDL_Palette * palette) const
+{
+	// Shares pixel data with our surface, but has its own format, palette and blit state
+	// Our surface is never modified while scaling its view, so same image can be scaled from multiple threads at once
+	SDL_Surface * view = SDL_CreateRGBSurfaceWithFormatFrom(surf->pixels, surf->w, surf->h, surf->format->BitsPerPixel, surf->pitch, surf->format->format);
+
+	if (surf->format->palette)
+	{
+		SDL_Palette * source = palette ? palette : surf->format->palette;
+		SDL_SetPaletteColors(view->format->palette, source->colors, 0, std::min(source->ncolors, view->format->palette->ncolors));
+	}
+
+	uint32_t colorKey;
+	if (SDL_GetColorKey(surf, &colorKey) == 0)
+		SDL_SetColorKey(view, SDL_TRUE, colorKey);
+
+	return view;
+}
+
 std::shared_ptr<ISharedImage> SDLImageShared::scaleInteger(int factor, SDL_Palette * palette) const
 {
 	if (factor <= 0)
 		throw std::runtime_error("Unable to scale by integer value of " + std::to_string(factor));
 
-	if (palette && surf && surf->format->palette)
-		SDL_SetSurfacePalette(surf, palette);
-
-	SDL_Surface * scaled = CSDL_Ext::scaleSurfaceIntegerFactor(surf, factor, EScalingAlgorithm::XBRZ);
+	SDL_Surface * view = surf ? createSurfaceView(palette) : nullptr;
+	SDL_Surface * scaled = CSDL_Ext::scaleSurfaceIntegerFactor(view, factor, EScalingAlgorithm::XBRZ);
+	SDL_FreeSurface(view);
 
 	auto ret = std::make_shared<SDLImageShared>(scaled);
 
@@ -288,9 +336,6 @@ std::shared_ptr<ISharedImage> SDLImageShared::scaleInteger(int factor, SDL_Palet
 	// erase our own reference
 	SDL_FreeSurface(scaled);
 
-	if (surf && surf->format->palette)
-		SDL_SetSurfacePalette(surf, originalPalette);
-
 	return ret;
 }
 
@@ -299,17 +344,19 @@ std::shared_ptr<ISharedImage> SDLImageShared::scaleTo(const Point & size, SDL_Pa
 	float scaleX = float(size.x) / dimensions().x;
 	float scaleY = float(size.y) / dimensions().y;
 
-	if (palette && surf->format->palette)
-		SDL_SetSurfacePalette(surf, palette);
-
-	auto scaled = CSDL_Ext::scaleSurface(surf, (int)(surf->w * scaleX), (int)(surf->h * scaleY));
+	SDL_Surface * view = surf ? createSurfaceView(palette) : nullptr;
+	auto scaled = view ? CSDL_Ext::scaleSurface(view, (int)(surf->w * scaleX), (int)(surf->h * scaleY)) : nullptr;
+	SDL_FreeSurface(view);
 
-	if (scaled->format && scaled->format->palette) // fix color keying, because SDL loses it at this point
-		CSDL_Ext::setColorKey(scaled, scaled->format->palette->colors[0]);
-	else if(scaled->format && scaled->format->Amask)
-		SDL_SetSurfaceBlendMode(scaled, SDL_BLENDMODE_BLEND);//just in case
-	else
-		CSDL_Ext::setDefaultColorKey(scaled);//just in case
+	if (scaled)
+	{
+		if (scaled->format && scaled->format->palette) // fix color keying, because SDL loses it at this point
+			CSDL_Ext::setColorKey(scaled, scaled->format->palette->colors[0]);
+		else if(scaled->format && scaled->format->Amask)
+			SDL_SetSurfaceBlendMode(scaled, SDL_BLENDMODE_BLEND);//just in case
+		else
+			CSDL_Ext::setDefaultColorKey(scaled);//just in case
+	}
 
 	auto ret = std::make_shared<SDLImageShared>(scaled);
 
@@ -322,9 +369,6 @@ std::shared_ptr<ISharedImage> SDLImageShared::scaleTo(const Point & size, SDL_Pa
 	// erase our own reference
 	SDL_FreeSurface(scaled);
 
-	if (surf->format->palette)
-		SDL_SetSurfacePalette(surf, originalPalette);
-
 	return ret;
 }
 
@@ -405,12 +449,9 @@ void SDLImageShared::savePalette()
 
 void SDLImageIndexed::shiftPalette(uint32_t firstColorID, uint32_t colorsToMove, uint32_t distanceToMove)
 {
-	std::vector<SDL_Color> shifterColors(colorsToMove);
-
+	// palette is never attached to any surface, so it can be updated in place, without allocations or SDL palette versioning
 	for(uint32_t i=0; i<colorsToMove; ++i)
-		shifterColors[(i+distanceToMove)%colorsToMove] = originalPalette->colors[firstColorID + i];
-
-	SDL_SetPaletteColors(currentPalette, shifterColors.data(), firstColorID, colorsToMove);
+		currentPalette->colors[firstColorID + (i+distanceToMove)%colorsToMove] = originalPalette->colors[firstColorID + i];
 }
 
 void SDLImageIndexed::adjustPalette(const ColorFilter & shifter, uint32_t colorsToSkipMask)
@@ -419,17 +460,27 @@ void SDLImageIndexed::adjustPalette(const ColorFilter & shifter, uint32_t colors
 	if (shadowEnabled)
 		colorsToSkipMask |= (1 << 0) + (1 << 1) + (1 << 4);
 
-	// Note: here we skip first colors in the palette that are predefined in H3 images
-	for(int i = 0; i < currentPalette->ncolors; i++)
+	if (!adjustedFilter || *adjustedFilter != shifter || adjustedSkipMask != colorsToSkipMask)
 	{
-		if (i < std::size(sourcePalette) && colorsSimilar(sourcePalette[i], originalPalette->colors[i]))
-			continue;
+		adjustedFilter = shifter;
+		adjustedSkipMask = colorsToSkipMask;
+		adjustedColors.clear();
+
+		// Note: here we skip first colors in the palette that are predefined in H3 images
+		for(int i = 0; i < currentPalette->ncolors; i++)
+		{
+			if (i < std::size(sourcePalette) && colorsSimilar(sourcePalette[i], originalPalette->colors[i]))
+				continue;
 
-		if(i < std::numeric_limits<uint32_t>::digits && ((colorsToSkipMask >> i) & 1) == 1)
-			continue;
+			if(i < std::numeric_limits<uint32_t>::digits && ((colorsToSkipMask >> i) & 1) == 1)
+				continue;
 
-		currentPalette->colors[i] = CSDL_Ext::toSDL(shifter.shiftColor(CSDL_Ext::fromSDL(originalPalette->colors[i])));
+			adjustedColors.emplace_back(i, shifter.shiftColor(CSDL_Ext::fromSDL(originalPalette->colors[i])));
+		}
 	}
+
+	for(const auto & [index, color] : adjustedColors)
+		currentPalette->colors[index] = CSDL_Ext::toSDL(color);
 }
 
 SDLImageIndexed::SDLImageIndexed(const std::shared_ptr<ISharedImage> & image, SDL_Palette * originalPalette, EImageBlitMode mode)
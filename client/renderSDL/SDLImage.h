@@ -9,7 +9,9 @@
  */
 #pragma once
 
+#include "../render/ColorFilter.h"
 #include "../render/IImage.h"
+#include "../../lib/Color.h"
 #include "../../lib/Point.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
@@ -34,12 +36,17 @@ class SDLImageShared final : public ISharedImage, public std::enable_shared_from
 	Point margins;
 	//total size including borders
 	Point fullSize;
+	//if set, pixel data of surf is located in this atlas surface
+	std::shared_ptr<SDL_Surface> atlas;
 
 	// Keep the original palette, in order to do color switching operation
 	void savePalette();
 
 	void optimizeSurface();
 
+	/// Creates surface that uses pixel data of this image with provided palette, for use as a source for scaling
+	SDL_Surface * createSurfaceView(SDL_Palette * palette) const;
+
 public:
 	//Load image from def file
 	SDLImageShared(const CDefFile *data, size_t frame, size_t group=0);
@@ -61,6 +68,8 @@ public:
 	std::shared_ptr<ISharedImage> scaleTo(const Point & size, SDL_Palette * palette) const override;
 
 	friend class SDLImageLoader;
+	friend class ScaledImageCache;
+	friend class ImageAtlas;
 };
 
 class SDLImageBase : public IImage, boost::noncopyable
@@ -90,6 +99,11 @@ class SDLImageIndexed final : public SDLImageBase
 	bool shadowEnabled = false;
 	bool overlayEnabled = false;
 
+	/// colors computed by last adjustPalette call. Battle animations apply same filter on every frame, so it only needs to be computed once
+	std::optional<ColorFilter> adjustedFilter;
+	uint32_t adjustedSkipMask = 0;
+	std::vector<std::pair<int, ColorRGBA>> adjustedColors;
+
 	void setShadowTransparency(float factor);
 public:
 	SDLImageIndexed(const std::shared_ptr<ISharedImage> & image, SDL_Palette * palette, EImageBlitMode mode);
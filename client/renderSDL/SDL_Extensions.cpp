@@ -27,6 +27,11 @@
 #include <SDL_surface.h>
 #include <SDL_version.h>
 
+#if !defined(VCMI_ENDIAN_BIG) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define VCMI_BLIT_SSE2
+#  include <emmintrin.h>
+#endif
+
 Rect CSDL_Ext::fromSDL(const SDL_Rect & rect)
 {
 	return Rect(Point(rect.x, rect.y), Point(rect.w, rect.h));
@@ -179,7 +184,7 @@ SDL_Surface * CSDL_Ext::horizontalFlip(SDL_Surface * toRot)
 	for(int i=0; i<ret->h; i++)
 	{
 		dst -= ret->pitch;
-		std::copy(src, src + toRot->pitch, dst);
+		std::copy(src, src + ret->w * ret->format->BytesPerPixel, dst);
 		src += toRot->pitch;
 	}
 	SDL_UnlockSurface(ret);
@@ -215,8 +220,76 @@ uint32_t CSDL_Ext::getPixel(SDL_Surface *surface, const int & x, const int & y,
 	}
 }
 
+static std::atomic<bool> simdBlitEnabled = true;
+
+void CSDL_Ext::setSimdBlitEnabled(bool enabled)
+{
+	simdBlitEnabled = enabled;
+}
+
+bool CSDL_Ext::isSimdBlitEnabled()
+{
+#ifdef VCMI_BLIT_SSE2
+	return simdBlitEnabled;
+#else
+	return false;
+#endif
+}
+
+#ifdef VCMI_BLIT_SSE2
+/// Blends row of 8-bit pixels into 32-bit destination, four pixels at a time
+/// Palette entries are packed as B, G, R, A bytes. Returns number of processed pixels, rest must be handled by caller
+static int blitRow8bppTo32bppSSE2(const uint8_t * src, uint8_t * dst, int width, const uint32_t * palette)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000));
+	const __m128i fullAlpha = _mm_set1_epi16(256);
+
+	int x = 0;
+	for(; x + 4 <= width; x += 4, src += 4, dst += 16)
+	{
+		const __m128i source = _mm_set_epi32(palette[src[3]], palette[src[2]], palette[src[1]], palette[src[0]]);
+		const __m128i sourceAlpha = _mm_and_si128(source, alphaMask);
+		const __m128i transparent = _mm_cmpeq_epi32(sourceAlpha, zero);
+		const __m128i opaque = _mm_cmpeq_epi32(sourceAlpha, alphaMask);
+
+		if(_mm_movemask_epi8(transparent) == 0xffff)
+			continue;
+
+		if(_mm_movemask_epi8(opaque) == 0xffff)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), source);
+			continue;
+		}
+
+		const __m128i target = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst));
+
+		// result = (src * A + dst * (256 - A)) >> 8, identical to ((src - dst) * A >> 8) + dst of scalar path
+		// sum never exceeds 255 * 256, so 16-bit lanes are sufficient
+		const __m128i sourceLow = _mm_unpacklo_epi8(source, zero);
+		const __m128i sourceHigh = _mm_unpackhi_epi8(source, zero);
+		const __m128i targetLow = _mm_unpacklo_epi8(target, zero);
+		const __m128i targetHigh = _mm_unpackhi_epi8(target, zero);
+
+		const __m128i alphaLow = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sourceLow, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		const __m128i alphaHigh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sourceHigh, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+		const __m128i blendedLow = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(sourceLow, alphaLow), _mm_mullo_epi16(targetLow, _mm_sub_epi16(fullAlpha, alphaLow))), 8);
+		const __m128i blendedHigh = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(sourceHigh, alphaHigh), _mm_mullo_epi16(targetHigh, _mm_sub_epi16(fullAlpha, alphaHigh))), 8);
+		const __m128i blended = _mm_or_si128(_mm_packus_epi16(blendedLow, blendedHigh), alphaMask);
+
+		// opaque pixels are copied as is, transparent ones keep destination unchanged, including its alpha
+		const __m128i colored = _mm_or_si128(_mm_and_si128(opaque, source), _mm_andnot_si128(opaque, blended));
+		const __m128i result = _mm_or_si128(_mm_and_si128(transparent, target), _mm_andnot_si128(transparent, colored));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), result);
+	}
+	return x;
+}
+#endif
+
 template<int bpp, bool useAlpha>
-int CSDL_Ext::blit8bppAlphaTo24bppT(const SDL_Surface * src, const Rect & srcRectInput, SDL_Surface * dst, const Point & dstPointInput, [[maybe_unused]] uint8_t alpha)
+int CSDL_Ext::blit8bppAlphaTo24bppT(const SDL_Surface * src, const Rect & srcRectInput, SDL_Surface * dst, const Point & dstPointInput, [[maybe_unused]] uint8_t alpha, const SDL_Color * palette)
 {
 	SDL_Rect srcRectInstance = CSDL_Ext::toSDL(srcRectInput);
 	SDL_Rect dstRectInstance = CSDL_Ext::toSDL(Rect(dstPointInput, srcRectInput.dimensions()));
@@ -327,16 +400,45 @@ int CSDL_Ext::blit8bppAlphaTo24bppT(const SDL_Surface * src, const Rect & srcRec
 			if(SDL_LockSurface(dst))
 				return -1; //if we cannot lock the surface
 
-			const SDL_Color *colors = src->format->palette->colors;
+			// palette can be overridden by caller, so per-image palette effects don't need to modify (possibly shared) source surface
+			const SDL_Color *colors = palette ? palette : src->format->palette->colors;
+			[[maybe_unused]] const int colorsCount = palette ? 256 : std::min(src->format->palette->ncolors, 256);
 			uint8_t *colory = (uint8_t*)src->pixels + srcy*src->pitch + srcx;
 			uint8_t *py = (uint8_t*)dst->pixels + dstRect->y*dst->pitch + dstRect->x*bpp;
 
+#ifdef VCMI_BLIT_SSE2
+			// same alpha as passed to PutColorAlphaSwitch, precomputed once per blit
+			const bool useSimd = bpp == 4 && w >= 4 && isSimdBlitEnabled();
+			std::array<uint32_t, 256> packedPalette;
+			if (useSimd)
+			{
+				for(int i = 0; i < colorsCount; ++i)
+				{
+					const SDL_Color &tbc = colors[i];
+					uint32_t effectiveAlpha = useAlpha ? int(alpha) * tbc.a / 255 : tbc.a;
+					packedPalette[i] = tbc.b | (tbc.g << 8) | (tbc.r << 16) | (effectiveAlpha << 24);
+				}
+				for(int i = colorsCount; i < 256; ++i)
+					packedPalette[i] = 0;
+			}
+#endif
+
 			for(int y=0; y<h; ++y, colory+=src->pitch, py+=dst->pitch)
 			{
 				uint8_t *color = colory;
 				uint8_t *p = py;
+				int x = 0;
+
+#ifdef VCMI_BLIT_SSE2
+				if (useSimd)
+				{
+					x = blitRow8bppTo32bppSSE2(color, p, w, packedPalette.data());
+					color += x;
+					p += x * bpp;
+				}
+#endif
 
-				for(int x = 0; x < w; ++x)
+				for(; x < w; ++x)
 				{
 					const SDL_Color &tbc = colors[*color++]; //color to blit
 					if constexpr (useAlpha)
@@ -353,22 +455,22 @@ int CSDL_Ext::blit8bppAlphaTo24bppT(const SDL_Surface * src, const Rect & srcRec
 	return 0;
 }
 
-int CSDL_Ext::blit8bppAlphaTo24bpp(const SDL_Surface * src, const Rect & srcRect, SDL_Surface * dst, const Point & dstPoint, uint8_t alpha)
+int CSDL_Ext::blit8bppAlphaTo24bpp(const SDL_Surface * src, const Rect & srcRect, SDL_Surface * dst, const Point & dstPoint, uint8_t alpha, const SDL_Color * palette)
 {
 	if (alpha == SDL_ALPHA_OPAQUE)
 	{
 		switch(dst->format->BytesPerPixel)
 		{
-		case 3: return blit8bppAlphaTo24bppT<3, false>(src, srcRect, dst, dstPoint, alpha);
-		case 4: return blit8bppAlphaTo24bppT<4, false>(src, srcRect, dst, dstPoint, alpha);
+		case 3: return blit8bppAlphaTo24bppT<3, false>(src, srcRect, dst, dstPoint, alpha, palette);
+		case 4: return blit8bppAlphaTo24bppT<4, false>(src, srcRect, dst, dstPoint, alpha, palette);
 		}
 	}
 	else
 	{
 		switch(dst->format->BytesPerPixel)
 		{
-			case 3: return blit8bppAlphaTo24bppT<3, true>(src, srcRect, dst, dstPoint, alpha);
-			case 4: return blit8bppAlphaTo24bppT<4, true>(src, srcRect, dst, dstPoint, alpha);
+			case 3: return blit8bppAlphaTo24bppT<3, true>(src, srcRect, dst, dstPoint, alpha, palette);
+			case 4: return blit8bppAlphaTo24bppT<4, true>(src, srcRect, dst, dstPoint, alpha, palette);
 		}
 	}
 
@@ -621,6 +723,77 @@ void CSDL_Ext::convertToGrayscaleBpp(SDL_Surface * surf, const Rect & rect )
 	}
 }
 
+void CSDL_Ext::copyScaledNearest(SDL_Surface * source, const Rect & sourceRect, SDL_Surface * target, const Rect & targetRect)
+{
+	assert(source->format->format == target->format->format);
+	assert(Rect(0, 0, source->w, source->h).contains(sourceRect));
+	assert(Rect(0, 0, target->w, target->h).contains(targetRect));
+
+	if(sourceRect.w <= 0 || sourceRect.h <= 0 || targetRect.w <= 0 || targetRect.h <= 0)
+		return;
+
+	const int bpp = target->format->BytesPerPixel;
+	const SDL_PixelFormat * format = target->format;
+	SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+	SDL_GetSurfaceBlendMode(source, &blendMode);
+
+	// same as SDL_BlitScaled: source surface without blending, e.g. any canvas that owns its surface, is copied as is
+	const bool blend = blendMode == SDL_BLENDMODE_BLEND && bpp == 4 && format->Amask != 0;
+
+	// source column of each target column is same for all rows
+	std::vector<int> sourceOffsets(targetRect.w);
+	for(int x = 0; x < targetRect.w; ++x)
+		sourceOffsets[x] = (sourceRect.x + x * sourceRect.w / targetRect.w) * bpp;
+
+	for(int y = 0; y < targetRect.h; ++y)
+	{
+		const uint8_t * sourceRow = static_cast<const uint8_t *>(source->pixels) + (sourceRect.y + y * sourceRect.h / targetRect.h) * source->pitch;
+		uint8_t * targetPixel = static_cast<uint8_t *>(target->pixels) + (targetRect.y + y) * target->pitch + targetRect.x * bpp;
+
+		for(int x = 0; x < targetRect.w; ++x, targetPixel += bpp)
+		{
+			const uint8_t * sourcePixel = sourceRow + sourceOffsets[x];
+
+			if(!blend)
+			{
+				memcpy(targetPixel, sourcePixel, bpp);
+				continue;
+			}
+
+			uint32_t sourceColor;
+			memcpy(&sourceColor, sourcePixel, sizeof(sourceColor));
+			uint8_t sourceAlpha = (sourceColor & format->Amask) >> format->Ashift;
+
+			if(sourceAlpha == SDL_ALPHA_OPAQUE)
+			{
+				memcpy(targetPixel, &sourceColor, sizeof(sourceColor));
+				continue;
+			}
+
+			if(sourceAlpha == SDL_ALPHA_TRANSPARENT)
+				continue;
+
+			// dstRGB = srcRGB * srcA + dstRGB * (1 - srcA), dstA = srcA + dstA * (1 - srcA)
+			uint32_t targetColor;
+			memcpy(&targetColor, targetPixel, sizeof(targetColor));
+
+			uint8_t sr, sg, sb, sa;
+			uint8_t dr, dg, db, da;
+			SDL_GetRGBA(sourceColor, format, &sr, &sg, &sb, &sa);
+			SDL_GetRGBA(targetColor, format, &dr, &dg, &db, &da);
+
+			auto blend = [sa](uint8_t source, uint8_t target)
+			{
+				return static_cast<uint8_t>((source * sa + target * (255 - sa)) / 255);
+			};
+
+			uint8_t resultAlpha = sa + da * (255 - sa) / 255;
+			targetColor = SDL_MapRGBA(format, blend(sr, dr), blend(sg, dg), blend(sb, db), resultAlpha);
+			memcpy(targetPixel, &targetColor, sizeof(targetColor));
+		}
+	}
+}
+
 void CSDL_Ext::convertToGrayscale( SDL_Surface * surf, const Rect & rect )
 {
 	switch(surf->format->BytesPerPixel)
@@ -81,10 +81,16 @@ using TColorPutterAlpha = void (*)(uint8_t *&, const uint8_t &, const uint8_t &,
 	TColorPutter getPutterFor(SDL_Surface * const & dest);
 
 	template<int bpp, bool useAlpha>
-	int blit8bppAlphaTo24bppT(const SDL_Surface * src, const Rect & srcRect, SDL_Surface * dst, const Point & dstPoint, uint8_t alpha); //blits 8 bpp surface with alpha channel to 24 bpp surface
-	int blit8bppAlphaTo24bpp(const SDL_Surface * src, const Rect & srcRect, SDL_Surface * dst, const Point & dstPoint, uint8_t alpha); //blits 8 bpp surface with alpha channel to 24 bpp surface
+	int blit8bppAlphaTo24bppT(const SDL_Surface * src, const Rect & srcRect, SDL_Surface * dst, const Point & dstPoint, uint8_t alpha, const SDL_Color * palette); //blits 8 bpp surface with alpha channel to 24 bpp surface
+	/// blits 8 bpp surface with alpha channel to 24 or 32 bpp surface
+	/// if palette is set, it must contain 256 colors and is used instead of palette of source surface
+	int blit8bppAlphaTo24bpp(const SDL_Surface * src, const Rect & srcRect, SDL_Surface * dst, const Point & dstPoint, uint8_t alpha, const SDL_Color * palette = nullptr);
 	uint32_t colorTouint32_t(const SDL_Color * color); //little endian only
 
+	/// enables or disables vectorized code path of 8-bit blits, if supported by platform. Used for comparison against scalar version
+	void setSimdBlitEnabled(bool enabled);
+	bool isSimdBlitEnabled();
+
 	void drawLine(SDL_Surface * sur, const Point & from, const Point & dest, const SDL_Color & color1, const SDL_Color & color2, int width);
 	void drawLineDashed(SDL_Surface * sur, const Point & from, const Point & dest, const SDL_Color & color);
 
@@ -101,6 +107,11 @@ using TColorPutterAlpha = void (*)(uint8_t *&, const uint8_t &, const uint8_t &,
 	SDL_Surface * scaleSurface(SDL_Surface * surf, int width, int height);
 	SDL_Surface * scaleSurfaceIntegerFactor(SDL_Surface * surf, int factor, EScalingAlgorithm scaler);
 
+	/// draws source area of one surface into target area of another surface with nearest-neighbour scaling
+	/// pixels are blended if source surface uses SDL_BLENDMODE_BLEND and copied otherwise, same as SDL_BlitScaled
+	/// both surfaces must have same pixel format. Only pixel data is accessed, so different threads may write into different target areas
+	void copyScaledNearest(SDL_Surface * source, const Rect & sourceRect, SDL_Surface * target, const Rect & targetRect);
+
 	template<int bpp>
 	void convertToGrayscaleBpp(SDL_Surface * surf, const Rect & rect);
 	void convertToGrayscale(SDL_Surface * surf, const Rect & rect);
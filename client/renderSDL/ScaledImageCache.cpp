@@ -0,0 +1,591 @@
+/*
+ * ScaledImageCache.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "ScaledImageCache.h"
+
+#include "SDLImage.h"
+
+#include "../render/ImageLocator.h"
+
+#include "../../lib/CStopWatch.h"
+#include "../../lib/VCMIDirs.h"
+
+#include <boost/interprocess/sync/file_lock.hpp>
+
+#include <SDL_surface.h>
+#include <zlib.h>
+
+// Pack file is only used on the machine where it was created, so all values are stored in native byte order
+static constexpr uint32_t packMagic = 0x43495356; // "VSIC"
+// must be increased whenever upscaling algorithm or pack format changes
+static constexpr uint32_t packVersion = 2;
+// once this size is reached, images that were not used in current session are removed on save
+static constexpr uint64_t packSizeLimit = 256 * 1024 * 1024;
+// once this amount of compressed data is waiting to be written, it is appended to pack file as new block
+static constexpr uint64_t pendingSizeLimit = 8 * 1024 * 1024;
+// size of pack file header (magic and version) and of header of each block (index size and data size)
+static constexpr uint64_t packHeaderSize = sizeof(uint32_t) * 2;
+static constexpr uint64_t blockHeaderSize = sizeof(uint32_t) + sizeof(uint64_t);
+
+namespace
+{
+class PackReader
+{
+	const uint8_t * data;
+	uint64_t size;
+	uint64_t position = 0;
+
+public:
+	PackReader(const uint8_t * data, uint64_t size)
+		: data(data)
+		, size(size)
+	{}
+
+	template<typename Type>
+	Type read()
+	{
+		Type result;
+		if(position + sizeof(Type) > size)
+			throw std::runtime_error("Unexpected end of file");
+		std::memcpy(&result, data + position, sizeof(Type));
+		position += sizeof(Type);
+		return result;
+	}
+
+	std::string readString()
+	{
+		auto length = read<uint16_t>();
+		if(position + length > size)
+			throw std::runtime_error("Unexpected end of file");
+		std::string result(reinterpret_cast<const char *>(data + position), length);
+		position += length;
+		return result;
+	}
+
+	uint64_t tell() const
+	{
+		return position;
+	}
+};
+
+class PackWriter
+{
+	std::vector<uint8_t> & data;
+
+public:
+	explicit PackWriter(std::vector<uint8_t> & data)
+		: data(data)
+	{}
+
+	template<typename Type>
+	void write(const Type & value)
+	{
+		const auto * bytes = reinterpret_cast<const uint8_t *>(&value);
+		data.insert(data.end(), bytes, bytes + sizeof(Type));
+	}
+
+	void writeString(const std::string & value)
+	{
+		write<uint16_t>(value.size());
+		data.insert(data.end(), value.begin(), value.end());
+	}
+};
+}
+
+ScaledImageCache::ScaledImageCache()
+	: packPath(VCMIDirs::get().userCachePath() / "scaledImages.pack")
+{
+	CStopWatch timer;
+	acquireLock();
+	loadIndex();
+	logGlobal->info("Opened scaled images cache with %d images in %d ms", entries.size(), timer.getDiff());
+}
+
+ScaledImageCache::~ScaledImageCache()
+{
+	compressionTasks.wait();
+}
+
+static void writeEntry(PackWriter & writer, const std::string & key, uint32_t sourceChecksum, uint32_t pixelFormat, const Point & dimensions, const Point & margins, const Point & fullSize, uint64_t offset, uint32_t compressedSize)
+{
+	writer.writeString(key);
+	writer.write(sourceChecksum);
+	writer.write(pixelFormat);
+	writer.write<int32_t>(dimensions.x);
+	writer.write<int32_t>(dimensions.y);
+	writer.write<int32_t>(margins.x);
+	writer.write<int32_t>(margins.y);
+	writer.write<int32_t>(fullSize.x);
+	writer.write<int32_t>(fullSize.y);
+	writer.write(offset);
+	writer.write(compressedSize);
+}
+
+void ScaledImageCache::acquireLock()
+{
+	boost::filesystem::path lockPath = packPath;
+	lockPath += ".lock";
+
+	try
+	{
+		boost::filesystem::create_directories(packPath.parent_path());
+
+		// lock file must exist before it can be locked
+		std::ofstream lockFile(lockPath.c_str(), std::ofstream::binary | std::ofstream::app);
+		lockFile.close();
+
+		packLock = std::make_unique<boost::interprocess::file_lock>(lockPath.c_str());
+		writable = packLock->try_lock();
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to lock scaled images cache: %s", e.what());
+		packLock.reset();
+		writable = false;
+	}
+
+	if(!writable)
+		logGlobal->info("Scaled images cache is used by another game instance, new upscaled images will not be stored");
+}
+
+void ScaledImageCache::loadIndex()
+{
+	entries.clear();
+	pack.close();
+	packSize = 0;
+
+	boost::system::error_code ec;
+	if(!boost::filesystem::exists(packPath, ec))
+		return;
+
+	try
+	{
+		uint64_t fileSize = boost::filesystem::file_size(packPath);
+		pack.open(packPath.c_str(), std::ios::binary);
+
+		std::vector<uint8_t> header(packHeaderSize);
+		if(!pack.read(reinterpret_cast<char *>(header.data()), header.size()))
+			throw std::runtime_error("Unexpected end of file");
+
+		PackReader headerReader(header.data(), header.size());
+		if(headerReader.read<uint32_t>() != packMagic || headerReader.read<uint32_t>() != packVersion)
+		{
+			logGlobal->info("Scaled images cache was created by different version and will be rebuilt");
+			pack.close();
+			if(writable)
+				boost::filesystem::remove(packPath, ec);
+			return;
+		}
+
+		uint64_t blockOffset = packHeaderSize;
+		while(blockOffset < fileSize)
+		{
+			std::vector<uint8_t> blockHeader(blockHeaderSize);
+			if(blockOffset + blockHeaderSize > fileSize || !pack.read(reinterpret_cast<char *>(blockHeader.data()), blockHeader.size()))
+				break;
+
+			PackReader blockReader(blockHeader.data(), blockHeader.size());
+			auto indexSize = blockReader.read<uint32_t>();
+			auto dataSize = blockReader.read<uint64_t>();
+			uint64_t dataOffset = blockOffset + blockHeaderSize + indexSize;
+
+			// block was not written completely, e.g. game was terminated while writing it
+			if(dataOffset + dataSize > fileSize)
+				break;
+
+			std::vector<uint8_t> index(indexSize);
+			if(!pack.read(reinterpret_cast<char *>(index.data()), index.size()))
+				break;
+
+			PackReader reader(index.data(), index.size());
+			auto entriesCount = reader.read<uint32_t>();
+			for(uint32_t i = 0; i < entriesCount; ++i)
+			{
+				std::string key = reader.readString();
+				Entry entry;
+				entry.sourceChecksum = reader.read<uint32_t>();
+				entry.pixelFormat = reader.read<uint32_t>();
+				entry.dimensions.x = reader.read<int32_t>();
+				entry.dimensions.y = reader.read<int32_t>();
+				entry.margins.x = reader.read<int32_t>();
+				entry.margins.y = reader.read<int32_t>();
+				entry.fullSize.x = reader.read<int32_t>();
+				entry.fullSize.y = reader.read<int32_t>();
+				entry.offset = dataOffset + reader.read<uint64_t>();
+				entry.compressedSize = reader.read<uint32_t>();
+
+				if(entry.offset + entry.compressedSize > dataOffset + dataSize)
+					throw std::runtime_error("Image data is out of block bounds");
+
+				// images from later blocks replace older versions of same image
+				entries[key] = entry;
+			}
+
+			blockOffset = dataOffset + dataSize;
+			pack.seekg(blockOffset);
+		}
+
+		// drop incomplete block, so new blocks are appended right after last valid one
+		// without lock, incomplete block may be one that is being written by another instance right now
+		if(blockOffset != fileSize && writable)
+		{
+			logGlobal->warn("Scaled images cache contains incomplete data which will be discarded");
+			pack.close();
+			boost::filesystem::resize_file(packPath, blockOffset);
+			pack.open(packPath.c_str(), std::ios::binary);
+		}
+
+		packSize = blockOffset;
+		logGlobal->debug("Loaded index of %d upscaled images", entries.size());
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to load scaled images cache: %s", e.what());
+		entries.clear();
+		pack.close();
+		packSize = 0;
+		if(writable)
+			boost::filesystem::remove(packPath, ec);
+	}
+}
+
+uint32_t ScaledImageCache::computeChecksum(const SDLImageShared & image)
+{
+	boost::crc_32_type checksum;
+
+	const SDL_Surface * surf = image.surf;
+	if(surf)
+	{
+		const auto * pixels = static_cast<const uint8_t *>(surf->pixels);
+		for(int y = 0; y < surf->h; ++y)
+			checksum.process_bytes(pixels + y * surf->pitch, surf->w * surf->format->BytesPerPixel);
+
+		if(surf->format->palette)
+			checksum.process_bytes(surf->format->palette->colors, surf->format->palette->ncolors * sizeof(SDL_Color));
+	}
+
+	std::array<int32_t, 4> geometry = { image.margins.x, image.margins.y, image.fullSize.x, image.fullSize.y };
+	checksum.process_bytes(geometry.data(), sizeof(geometry));
+
+	return checksum.checksum();
+}
+
+bool ScaledImageCache::readCompressedData(const Entry & entry, std::vector<uint8_t> & result)
+{
+	if(entry.pendingData)
+	{
+		result = *entry.pendingData;
+		return true;
+	}
+
+	result.resize(entry.compressedSize);
+	pack.clear();
+	pack.seekg(entry.offset);
+	return static_cast<bool>(pack.read(reinterpret_cast<char *>(result.data()), result.size()));
+}
+
+std::shared_ptr<ISharedImage> ScaledImageCache::load(const ImageLocator & locator, const ISharedImage & source)
+{
+	const auto * sourceImage = dynamic_cast<const SDLImageShared *>(&source);
+	if(!sourceImage)
+		return nullptr;
+
+	uint32_t sourceChecksum = computeChecksum(*sourceImage);
+	Entry entry;
+	std::vector<uint8_t> compressed;
+	{
+		std::lock_guard lock(entriesMutex);
+		auto it = entries.find(locator.toString());
+		if(it == entries.end() || it->second.sourceChecksum != sourceChecksum)
+			return nullptr;
+
+		if(!readCompressedData(it->second, compressed))
+		{
+			logGlobal->warn("Failed to read cached image %s", it->first);
+			return nullptr;
+		}
+
+		it->second.used = true;
+		entry = it->second;
+	}
+
+	SDL_Surface * surface = SDL_CreateRGBSurfaceWithFormat(0, entry.dimensions.x, entry.dimensions.y, 32, entry.pixelFormat);
+	if(!surface)
+		return nullptr;
+
+	std::vector<uint8_t> pixels(entry.dimensions.x * entry.dimensions.y * 4);
+	uLongf decompressedSize = pixels.size();
+
+	if(uncompress(pixels.data(), &decompressedSize, compressed.data(), compressed.size()) != Z_OK || decompressedSize != pixels.size())
+	{
+		logGlobal->warn("Failed to decompress cached image %s", locator.toString());
+		SDL_FreeSurface(surface);
+		return nullptr;
+	}
+
+	for(int y = 0; y < surface->h; ++y)
+		std::memcpy(static_cast<uint8_t *>(surface->pixels) + y * surface->pitch, pixels.data() + y * surface->w * 4, surface->w * 4);
+
+	auto result = std::make_shared<SDLImageShared>(surface);
+	result->margins = entry.margins;
+	result->fullSize = entry.fullSize;
+	SDL_FreeSurface(surface);
+
+	return result;
+}
+
+void ScaledImageCache::store(const ImageLocator & locator, const ISharedImage & source, const ISharedImage & scaled)
+{
+	const auto * sourceImage = dynamic_cast<const SDLImageShared *>(&source);
+	const auto * scaledImage = dynamic_cast<const SDLImageShared *>(&scaled);
+
+	if(!writable || !sourceImage || !scaledImage)
+		return;
+
+	const SDL_Surface * surf = scaledImage->surf;
+
+	// upscaling always produces 32-bit images, anything else is not supported by cache
+	if(!surf || surf->format->BytesPerPixel != 4 || surf->format->palette || surf->w == 0 || surf->h == 0)
+		return;
+
+	auto pixels = std::make_shared<std::vector<uint8_t>>(surf->w * surf->h * 4);
+	for(int y = 0; y < surf->h; ++y)
+		std::memcpy(pixels->data() + y * surf->w * 4, static_cast<const uint8_t *>(surf->pixels) + y * surf->pitch, surf->w * 4);
+
+	Entry entry;
+	entry.sourceChecksum = computeChecksum(*sourceImage);
+	entry.pixelFormat = surf->format->format;
+	entry.dimensions = Point(surf->w, surf->h);
+	entry.margins = scaledImage->margins;
+	entry.fullSize = scaledImage->fullSize;
+	entry.used = true;
+
+	// compression is slower than copying of pixels, and store may be called by main thread
+	compressionTasks.run([this, key = locator.toString(), entry, pixels]()
+	{
+		compressAndStore(key, entry, *pixels);
+	});
+}
+
+void ScaledImageCache::compressAndStore(const std::string & key, Entry entry, const std::vector<uint8_t> & pixels)
+{
+	uLongf compressedSize = compressBound(pixels.size());
+	auto compressed = std::make_shared<std::vector<uint8_t>>(compressedSize);
+
+	if(compress2(compressed->data(), &compressedSize, pixels.data(), pixels.size(), Z_BEST_SPEED) != Z_OK)
+		return;
+
+	compressed->resize(compressedSize);
+	compressed->shrink_to_fit();
+	entry.compressedSize = compressedSize;
+	entry.pendingData = compressed;
+
+	bool appendRequired;
+	{
+		std::lock_guard lock(entriesMutex);
+		auto & stored = entries[key];
+		if(stored.pendingData)
+			pendingSize -= stored.compressedSize;
+		stored = entry;
+		pendingSize += entry.compressedSize;
+		appendRequired = pendingSize >= pendingSizeLimit;
+	}
+
+	if(appendRequired)
+		appendPendingImages();
+}
+
+void ScaledImageCache::appendPendingImages()
+{
+	std::lock_guard writeLock(packWriteMutex);
+
+	std::vector<uint8_t> index;
+	PackWriter writer(index);
+	std::vector<std::pair<std::string, std::shared_ptr<const std::vector<uint8_t>>>> writtenImages;
+	uint64_t dataSize = 0;
+	uint64_t blockOffset;
+
+	{
+		std::lock_guard lock(entriesMutex);
+
+		for(const auto & [key, entry] : entries)
+		{
+			if(!entry.pendingData)
+				continue;
+
+			writeEntry(writer, key, entry.sourceChecksum, entry.pixelFormat, entry.dimensions, entry.margins, entry.fullSize, dataSize, entry.compressedSize);
+			writtenImages.emplace_back(key, entry.pendingData);
+			dataSize += entry.compressedSize;
+		}
+		blockOffset = packSize;
+	}
+
+	if(writtenImages.empty())
+		return;
+
+	std::vector<uint8_t> header;
+	PackWriter headerWriter(header);
+	if(blockOffset == 0)
+	{
+		headerWriter.write(packMagic);
+		headerWriter.write(packVersion);
+		blockOffset = packHeaderSize;
+	}
+	headerWriter.write<uint32_t>(index.size() + sizeof(uint32_t));
+	headerWriter.write<uint64_t>(dataSize);
+	headerWriter.write<uint32_t>(writtenImages.size());
+
+	bool success = false;
+	try
+	{
+		boost::filesystem::create_directories(packPath.parent_path());
+
+		std::ofstream file(packPath.c_str(), std::ofstream::binary | std::ofstream::app);
+		file.write(reinterpret_cast<const char *>(header.data()), header.size());
+		file.write(reinterpret_cast<const char *>(index.data()), index.size());
+		for(const auto & image : writtenImages)
+			file.write(reinterpret_cast<const char *>(image.second->data()), image.second->size());
+
+		success = static_cast<bool>(file.flush());
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to write scaled images cache: %s", e.what());
+	}
+
+	uint64_t dataOffset = blockOffset + blockHeaderSize + sizeof(uint32_t) + index.size();
+
+	std::lock_guard lock(entriesMutex);
+
+	if(!success)
+	{
+		// drop partially written block, and do not keep data that can't be written in memory
+		boost::system::error_code ec;
+		if(packSize == 0)
+			boost::filesystem::remove(packPath, ec);
+		else
+			boost::filesystem::resize_file(packPath, packSize, ec);
+
+		for(const auto & [key, data] : writtenImages)
+		{
+			auto it = entries.find(key);
+			if(it != entries.end() && it->second.pendingData == data)
+			{
+				pendingSize -= it->second.compressedSize;
+				entries.erase(it);
+			}
+		}
+		return;
+	}
+
+	uint64_t offset = 0;
+	for(const auto & [key, data] : writtenImages)
+	{
+		// image could have been replaced while block was written - keep newer version pending
+		auto it = entries.find(key);
+		if(it != entries.end() && it->second.pendingData == data)
+		{
+			it->second.pendingData.reset();
+			it->second.offset = dataOffset + offset;
+			pendingSize -= it->second.compressedSize;
+		}
+		offset += data->size();
+	}
+
+	packSize = dataOffset + dataSize;
+	pack.close();
+	pack.open(packPath.c_str(), std::ios::binary);
+	logGlobal->debug("Stored %d upscaled images, %d KB", writtenImages.size(), (header.size() + index.size() + dataSize) / 1024);
+}
+
+void ScaledImageCache::rewritePack()
+{
+	std::lock_guard writeLock(packWriteMutex);
+	std::lock_guard lock(entriesMutex);
+
+	std::vector<uint8_t> index;
+	PackWriter writer(index);
+	std::vector<std::string> storedKeys;
+	uint64_t dataSize = 0;
+
+	for(const auto & [key, entry] : entries)
+	{
+		if(!entry.used)
+			continue;
+
+		writeEntry(writer, key, entry.sourceChecksum, entry.pixelFormat, entry.dimensions, entry.margins, entry.fullSize, dataSize, entry.compressedSize);
+		storedKeys.push_back(key);
+		dataSize += entry.compressedSize;
+	}
+
+	std::vector<uint8_t> header;
+	PackWriter headerWriter(header);
+	headerWriter.write(packMagic);
+	headerWriter.write(packVersion);
+	headerWriter.write<uint32_t>(index.size() + sizeof(uint32_t));
+	headerWriter.write<uint64_t>(dataSize);
+	headerWriter.write<uint32_t>(storedKeys.size());
+
+	boost::filesystem::path temporaryPath = packPath;
+	temporaryPath += ".tmp";
+
+	try
+	{
+		{
+			std::ofstream file(temporaryPath.c_str(), std::ofstream::binary | std::ofstream::trunc);
+			file.write(reinterpret_cast<const char *>(header.data()), header.size());
+			file.write(reinterpret_cast<const char *>(index.data()), index.size());
+
+			std::vector<uint8_t> compressed;
+			for(const auto & key : storedKeys)
+			{
+				if(!readCompressedData(entries.at(key), compressed))
+					throw std::runtime_error("Failed to read image " + key);
+				file.write(reinterpret_cast<const char *>(compressed.data()), compressed.size());
+			}
+
+			if(!file)
+				throw std::runtime_error("Failed to write " + temporaryPath.string());
+		}
+
+		// file must be closed before it can be replaced
+		pack.close();
+		boost::filesystem::rename(temporaryPath, packPath);
+		logGlobal->debug("Removed unused images from scaled images cache, %d images left, %d KB", storedKeys.size(), (header.size() + index.size() + dataSize) / 1024);
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to save scaled images cache: %s", e.what());
+		boost::system::error_code ec;
+		boost::filesystem::remove(temporaryPath, ec);
+	}
+
+	pendingSize = 0;
+	loadIndex();
+}
+
+void ScaledImageCache::save()
+{
+	if(!writable)
+		return;
+
+	compressionTasks.wait();
+	appendPendingImages();
+
+	// pack is too large - keep only images used in this session
+	bool rewriteRequired;
+	{
+		std::lock_guard lock(entriesMutex);
+		rewriteRequired = packSize > packSizeLimit;
+	}
+
+	if(rewriteRequired)
+		rewritePack();
+}
@@ -0,0 +1,88 @@
+/*
+ * ScaledImageCache.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../../lib/Point.h"
+
+#include <tbb/task_group.h>
+
+namespace boost::interprocess
+{
+class file_lock;
+}
+
+struct ImageLocator;
+class ISharedImage;
+class SDLImageShared;
+
+/// Persistent storage of upscaled images, so upscaling of each image is only done once and not on every game start
+/// All images are stored in a single pack file that consists of blocks, each block is an index of its images followed by zlib-compressed pixel data
+/// New images are compressed on background thread and appended to pack file as new block once enough of them is collected
+/// Pixel data is only read from pack file once specific image is requested
+/// All public methods are thread-safe
+/// Pack file is only modified by process that holds lock file, other running game instances use cache in read-only mode
+class ScaledImageCache : boost::noncopyable
+{
+	struct Entry
+	{
+		/// checksum of unscaled image, to detect changes in game data or mods
+		uint32_t sourceChecksum = 0;
+		/// SDL_PixelFormatEnum of stored pixels
+		uint32_t pixelFormat = 0;
+		Point dimensions;
+		Point margins;
+		Point fullSize;
+		/// offset of compressed data in pack file
+		uint64_t offset = 0;
+		uint32_t compressedSize = 0;
+		/// compressed data of image that was upscaled in this session and is not written to pack file yet
+		std::shared_ptr<const std::vector<uint8_t>> pendingData;
+		/// image was requested in this session
+		bool used = false;
+	};
+
+	boost::filesystem::path packPath;
+	std::unique_ptr<boost::interprocess::file_lock> packLock;
+	/// this process holds lock of pack file and may modify it
+	bool writable = false;
+	std::ifstream pack;
+	uint64_t packSize = 0;
+
+	std::map<std::string, Entry> entries;
+	/// total size of compressed data that is not written to pack file yet
+	uint64_t pendingSize = 0;
+	std::mutex entriesMutex;
+
+	/// held while pack file is written, so only one thread appends to it at once
+	std::mutex packWriteMutex;
+	tbb::task_group compressionTasks;
+
+	void acquireLock();
+	void loadIndex();
+	bool readCompressedData(const Entry & entry, std::vector<uint8_t> & result);
+	void compressAndStore(const std::string & key, Entry entry, const std::vector<uint8_t> & pixels);
+	void appendPendingImages();
+	void rewritePack();
+
+	static uint32_t computeChecksum(const SDLImageShared & image);
+
+public:
+	ScaledImageCache();
+	~ScaledImageCache();
+
+	/// Returns upscaled version of source image if it is present in cache, or nullptr otherwise
+	std::shared_ptr<ISharedImage> load(const ImageLocator & locator, const ISharedImage & source);
+
+	/// Adds upscaled image to cache. Image is compressed on background thread and written to disk later
+	void store(const ImageLocator & locator, const ISharedImage & source, const ISharedImage & scaled);
+
+	/// Writes all images that were added in this session and are not written yet to pack file
+	void save();
+};
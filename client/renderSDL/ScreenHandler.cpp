@@ -415,6 +415,9 @@ void ScreenHandler::initializeScreenBuffers()
 	else
 		screenBuf = screen;
 
+	dirtyRegions.clear();
+	fullUpdateRequested = true;
+
 	clearScreen();
 }
 
@@ -613,6 +616,87 @@ void ScreenHandler::clearScreen()
 	SDL_RenderPresent(mainRenderer);
 }
 
+void ScreenHandler::markDirty(const Rect & area)
+{
+	const Rect screenArea(0, 0, screen->w, screen->h);
+	Rect region = (area * getScalingFactor()).intersect(screenArea);
+
+	if(region.w <= 0 || region.h <= 0)
+		return;
+
+	// most of frames only redraw top window and widgets inside it, so regions often repeat or overlap
+	for(auto it = dirtyRegions.begin(); it != dirtyRegions.end();)
+	{
+		if(!it->intersectionTest(region))
+		{
+			++it;
+			continue;
+		}
+
+		region = region.include(*it);
+		dirtyRegions.erase(it);
+		it = dirtyRegions.begin();
+	}
+	dirtyRegions.push_back(region);
+}
+
+void ScreenHandler::updateScreenTexture()
+{
+	updatedRegions.clear();
+
+	if(fullUpdateRequested)
+	{
+		SDL_UpdateTexture(screenTexture, nullptr, screen->pixels, screen->pitch);
+		updatedRegions.emplace_back(0, 0, screen->w, screen->h);
+		dirtyRegions.clear();
+		fullUpdateRequested = false;
+		return;
+	}
+
+	for(const auto & region : dirtyRegions)
+	{
+		SDL_Rect rect = CSDL_Ext::toSDL(region);
+		const uint8_t * pixels = static_cast<const uint8_t *>(screen->pixels) + region.y * screen->pitch + region.x * screen->format->BytesPerPixel;
+		SDL_UpdateTexture(screenTexture, &rect, pixels, screen->pitch);
+	}
+	std::swap(updatedRegions, dirtyRegions);
+}
+
+void ScreenHandler::presentScreenTexture()
+{
+	SDL_RenderClear(mainRenderer);
+	SDL_RenderCopy(mainRenderer, screenTexture, nullptr, nullptr);
+
+	if(settings["session"]["showRedrawRegions"].Bool())
+	{
+		SDL_Color oldColor;
+		SDL_BlendMode oldBlendMode;
+		SDL_GetRenderDrawColor(mainRenderer, &oldColor.r, &oldColor.g, &oldColor.b, &oldColor.a);
+		SDL_GetRenderDrawBlendMode(mainRenderer, &oldBlendMode);
+
+		SDL_SetRenderDrawBlendMode(mainRenderer, SDL_BLENDMODE_BLEND);
+		SDL_SetRenderDrawColor(mainRenderer, 255, 0, 0, 64);
+		for(const auto & region : updatedRegions)
+		{
+			SDL_Rect rect = CSDL_Ext::toSDL(region);
+			SDL_RenderFillRect(mainRenderer, &rect);
+		}
+		SDL_SetRenderDrawColor(mainRenderer, 255, 0, 0, 255);
+		for(const auto & region : updatedRegions)
+		{
+			SDL_Rect rect = CSDL_Ext::toSDL(region);
+			SDL_RenderDrawRect(mainRenderer, &rect);
+		}
+		SDL_SetRenderDrawColor(mainRenderer, oldColor.r, oldColor.g, oldColor.b, oldColor.a);
+		SDL_SetRenderDrawBlendMode(mainRenderer, oldBlendMode);
+	}
+}
+
+void ScreenHandler::invalidateScreenTexture()
+{
+	fullUpdateRequested = true;
+}
+
 std::vector<Point> ScreenHandler::getSupportedResolutions() const
 {
 	int displayID = getPreferredDisplayIndex();
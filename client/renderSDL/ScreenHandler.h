@@ -15,7 +15,7 @@ struct SDL_Window;
 struct SDL_Renderer;
 struct SDL_Surface;
 
-#include "../../lib/Point.h"
+#include "../../lib/Rect.h"
 #include "../render/IScreenHandler.h"
 
 enum class EWindowMode
@@ -46,6 +46,12 @@ class ScreenHandler final : public IScreenHandler
 {
 	EUpscalingFilter upscalingFilter = EUpscalingFilter::AUTO;
 
+	/// regions of screen surface, in pixels, that were modified since previous upload to screen texture
+	std::vector<Rect> dirtyRegions;
+	/// regions of screen texture that were updated on last frame, for debug overlay
+	std::vector<Rect> updatedRegions;
+	bool fullUpdateRequested = true;
+
 	/// Dimensions of target surfaces/textures, this value is what game logic views as screen size
 	Point getPreferredLogicalResolution() const;
 
@@ -102,6 +108,11 @@ public:
 	/// Fills screen with black color, erasing any existing content
 	void clearScreen() final;
 
+	void updateScreenTexture() final;
+	void presentScreenTexture() final;
+	void invalidateScreenTexture() final;
+	void markDirty(const Rect & area) final;
+
 	/// Dimensions of render output, usually same as window size except for high-DPI screens on macOS / iOS
 	Point getRenderResolution() const final;
 
@@ -602,11 +602,13 @@ void CCastleBuildings::recreate()
 		}
 	}
 
+	std::vector<const CStructure *> shownStructures;
+
 	for(const CStructure * structure : town->town->clientInfo.structures)
 	{
 		if(!structure->building)
 		{
-			buildings.push_back(std::make_shared<CBuildingRect>(this, town, structure));
+			shownStructures.push_back(structure);
 			continue;
 		}
 		if(vstd::contains(buildingsCopy, structure->building->bid))
@@ -624,9 +626,18 @@ void CCastleBuildings::recreate()
 			return build->getDistance(a->building->bid) < build->getDistance(b->building->bid);
 		});
 
-		buildings.push_back(std::make_shared<CBuildingRect>(this, town, toAdd));
+		shownStructures.push_back(toAdd);
 	}
 
+	// unpack, decode and upscale animations of all buildings in background, while buildings are created one by one
+	std::vector<AnimationPath> animations;
+	for(const CStructure * structure : shownStructures)
+		animations.push_back(structure->defName);
+	GH.renderHandler().prefetchAnimations(animations, EImageBlitMode::COLORKEY);
+
+	for(const CStructure * structure : shownStructures)
+		buildings.push_back(std::make_shared<CBuildingRect>(this, town, structure));
+
 	const auto & buildSorter = [](const CIntObject * a, const CIntObject * b)
 	{
 		auto b1 = dynamic_cast<const CBuildingRect *>(a);
@@ -1278,6 +1289,7 @@ CCastleInterface::CCastleInterface(const CGTownInstance * Town, const CGTownInst
 	town(Town)
 {
 	OBJECT_CONSTRUCTION;
+	auto openingStart = std::chrono::steady_clock::now();
 
 	LOCPLINT->castleInt = this;
 	addUsedEvents(KEYBOARD);
@@ -1323,6 +1335,9 @@ CCastleInterface::CCastleInterface(const CGTownInstance * Town, const CGTownInst
 	if (!from)
 		adventureInt->onAudioPaused();
 	CCS->musich->playMusicFromSet("faction", town->town->faction->getJsonKey(), true, false);
+
+	auto openingTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - openingStart);
+	logGlobal->debug("Town screen of %s opened in %d ms", town->getNameTranslated(), openingTime.count());
 }
 
 CCastleInterface::~CCastleInterface()
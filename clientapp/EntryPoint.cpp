@@ -21,6 +21,7 @@
 #include "../client/eventsSDL/InputHandler.h"
 #include "../client/gui/CGuiHandler.h"
 #include "../client/gui/CursorHandler.h"
+#include "../client/gui/FrameProfiler.h"
 #include "../client/gui/WindowHandler.h"
 #include "../client/mainmenu/CMainMenu.h"
 #include "../client/media/CEmptyVideoPlayer.h"
@@ -123,6 +124,9 @@ int main(int argc, char * argv[])
 	setenv("LANG", "C", 1);
 #endif
 
+	// paths in command line options are relative to directory in which client was started
+	const auto workingDir = boost::filesystem::current_path();
+
 #if !defined(VCMI_MOBILE)
 	// Correct working dir executable folder (not bundle folder) so we can use executable relative paths
 	boost::filesystem::current_path(boost::filesystem::system_complete(argv[0]).parent_path());
@@ -151,7 +155,8 @@ int main(int argc, char * argv[])
 		("nointro,i", "skips intro movies")
 		("donotstartserver,d","do not attempt to start server and just connect to it instead server")
 		("serverport", po::value<si64>(), "override port specified in config file")
-		("savefrequency", po::value<si64>(), "limit auto save creation to each N days");
+		("savefrequency", po::value<si64>(), "limit auto save creation to each N days")
+		("frame-trace", po::value<std::string>(), "write time spent on each frame by main loop and rendering to specified file in Chrome trace format");
 
 	if(argc > 1)
 	{
@@ -280,8 +285,13 @@ int main(int argc, char * argv[])
 	srand ( (unsigned int)time(nullptr) );
 
 	if(!settings["session"]["headless"].Bool())
+	{
 		GH.init();
 
+		if(vm.count("frame-trace"))
+			GH.profiler().startTrace(boost::filesystem::absolute(vm["frame-trace"].as<std::string>(), workingDir));
+	}
+
 	CCS = new CClientState();
 	CGI = new CGameInfo(); //contains all global information about game (texts, lodHandlers, map handler etc.)
 	CSH = new CServerHandler();
@@ -469,7 +479,11 @@ static void mainLoop()
 	//vstd::clear_pointer(console);// should be removed after everything else since used by logging
 
 	if(!settings["session"]["headless"].Bool())
+	{
+		GH.profiler().stopTrace();
+		GH.renderHandler().saveScaledImages();
 		GH.screenHandler().close();
+	}
 
 	if(logConfig != nullptr)
 	{
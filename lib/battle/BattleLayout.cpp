@@ -24,6 +24,11 @@ BattleLayout BattleLayout::createDefaultLayout(IGameCallback * cb, const CArmedI
 }
 
 BattleLayout BattleLayout::createLayout(IGameCallback * cb, const std::string & layoutName, const CArmedInstance * attacker, const CArmedInstance * defender)
+{
+	return createLayout(cb->getSettings(), layoutName, attacker, defender);
+}
+
+BattleLayout BattleLayout::createLayout(const IGameSettings & settings, const std::string & layoutName, const CArmedInstance * attacker, const CArmedInstance * defender)
 {
 	const auto & loadHex = [](const JsonNode & node)
 	{
@@ -44,7 +49,7 @@ BattleLayout BattleLayout::createLayout(IGameCallback * cb, const std::string &
 		return result;
 	};
 
-	const JsonNode & configRoot = cb->getSettings().getValue(EGameSettings::COMBAT_LAYOUTS);
+	const JsonNode & configRoot = settings.getValue(EGameSettings::COMBAT_LAYOUTS);
 	const JsonNode & config = configRoot[layoutName];
 
 	BattleLayout result;
@@ -18,6 +18,7 @@ VCMI_LIB_NAMESPACE_BEGIN
 
 class CArmedInstance;
 class IGameCallback;
+class IGameSettings;
 
 struct DLL_EXPORT BattleLayout
 {
@@ -34,6 +35,7 @@ struct DLL_EXPORT BattleLayout
 
 	static BattleLayout createDefaultLayout(IGameCallback * cb, const CArmedInstance * attacker, const CArmedInstance * defender);
 	static BattleLayout createLayout(IGameCallback * cb, const std::string & layoutName, const CArmedInstance * attacker, const CArmedInstance * defender);
+	static BattleLayout createLayout(const IGameSettings & settings, const std::string & layoutName, const CArmedInstance * attacker, const CArmedInstance * defender);
 };
 
 VCMI_LIB_NAMESPACE_END
@@ -867,7 +867,7 @@ void CTownHandler::beforeValidate(JsonNode & object)
 		if (buildingsLibrary.Struct().count(name) == 0)
 			return;
 
-		JsonNode baseCopy(buildingsLibrary[name]);
+		JsonNode baseCopy(std::as_const(buildingsLibrary)[name]);
 		baseCopy.setModScope(target.getModScope());
 		JsonUtils::inherit(target, baseCopy);
 	};
@@ -11,6 +11,7 @@
 #include "AdapterLoaders.h"
 
 #include "Filesystem.h"
+#include "ResourcePrefetcher.h"
 #include "../json/JsonNode.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
@@ -56,20 +57,31 @@ std::unordered_set<ResourcePath> CMappedFileLoader::getFilteredFiles(std::functi
 	return foundID;
 }
 
-CFilesystemList::CFilesystemList()
+CFilesystemList::CFilesystemList():
+	prefetcher(std::make_unique<ResourcePrefetcher>())
 {
 }
 
 CFilesystemList::~CFilesystemList()
 {
+	// background loading may still use loaders of this list
+	prefetcher.reset();
 }
 
 std::unique_ptr<CInputStream> CFilesystemList::load(const ResourcePath & resourceName) const
 {
 	// load resource from last loader that have it (last overridden version)
 	for(const auto & loader : boost::adaptors::reverse(loaders))
+	{
 		if (loader->existsResource(resourceName))
+		{
+			auto prefetched = prefetcher->take(resourceName, loader.get());
+			if (prefetched)
+				return prefetched;
+
 			return loader->load(resourceName);
+		}
+	}
 
 	throw std::runtime_error("Resource with name " + resourceName.getName() + " and type "
 		+ EResTypeHelper::getEResTypeAsString(resourceName.getType()) + " wasn't found.");
@@ -95,6 +107,13 @@ std::optional<boost::filesystem::path> CFilesystemList::getResourceName(const Re
 	return std::optional<boost::filesystem::path>();
 }
 
+std::optional<ui32> CFilesystemList::getResourceChecksum(const ResourcePath & resourceName) const
+{
+	if (existsResource(resourceName))
+		return getResourcesWithName(resourceName).back()->getResourceChecksum(resourceName);
+	return std::nullopt;
+}
+
 std::set<boost::filesystem::path> CFilesystemList::getResourceNames(const ResourcePath & resourceName) const
 {
 	std::set<boost::filesystem::path> paths;
@@ -157,8 +176,25 @@ std::vector<const ISimpleResourceLoader *> CFilesystemList::getResourcesWithName
 	return ret;
 }
 
+void CFilesystemList::prefetch(const std::vector<ResourcePath> & resources) const
+{
+	for(const auto & resource : resources)
+	{
+		for(const auto & loader : boost::adaptors::reverse(loaders))
+		{
+			if (loader->existsResource(resource))
+			{
+				prefetcher->prefetch(resource, loader.get());
+				break;
+			}
+		}
+	}
+}
+
 void CFilesystemList::addLoader(ISimpleResourceLoader * loader, bool writeable)
 {
+	// new loader may override some of prefetched resources
+	prefetcher->clear();
 	loaders.push_back(std::unique_ptr<ISimpleResourceLoader>(loader));
 	if (writeable)
 		writeableLoaders.insert(loader);
@@ -170,6 +206,7 @@ bool CFilesystemList::removeLoader(ISimpleResourceLoader * loader)
 	{
 		if(loaderIterator->get() == loader)
 		{
+			prefetcher->clear();
 			loaders.erase(loaderIterator);
 			writeableLoaders.erase(loader);
 			return true;
@@ -16,6 +16,7 @@ VCMI_LIB_NAMESPACE_BEGIN
 
 class CInputStream;
 class JsonNode;
+class ResourcePrefetcher;
 
 /**
  * Class that implements file mapping (aka *nix symbolic links)
@@ -59,6 +60,9 @@ class DLL_LINKAGE CFilesystemList : public ISimpleResourceLoader
 
 	std::set<ISimpleResourceLoader *> writeableLoaders;
 
+	/// resources that were loaded in advance by prefetch()
+	std::unique_ptr<ResourcePrefetcher> prefetcher;
+
 	//FIXME: this is only compile fix, should be removed in the end
 	CFilesystemList(CFilesystemList &) = delete;
 	CFilesystemList &operator=(CFilesystemList &) = delete;
@@ -72,11 +76,13 @@ public:
 	bool existsResource(const ResourcePath & resourceName) const override;
 	std::string getMountPoint() const override;
 	std::optional<boost::filesystem::path> getResourceName(const ResourcePath & resourceName) const override;
+	std::optional<ui32> getResourceChecksum(const ResourcePath & resourceName) const override;
 	std::set<boost::filesystem::path> getResourceNames(const ResourcePath & resourceName) const override;
 	void updateFilteredFiles(std::function<bool(const std::string &)> filter) const override;
 	std::unordered_set<ResourcePath> getFilteredFiles(std::function<bool(const ResourcePath &)> filter) const override;
 	bool createResource(const std::string & filename, bool update = false) override;
 	std::vector<const ISimpleResourceLoader *> getResourcesWithName(const ResourcePath & resourceName) const override;
+	void prefetch(const std::vector<ResourcePath> & resources) const override;
 
 	/**
 	 * Adds a resource loader to the loaders list
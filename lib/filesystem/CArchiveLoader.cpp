@@ -13,9 +13,13 @@
 #include "VCMIDirs.h"
 #include "CFileInputStream.h"
 #include "CCompressedStream.h"
+#include "CMappedFileStream.h"
+#include "ResourceIndexCache.h"
 
 #include "CBinaryReader.h"
 
+#include "../json/JsonNode.h"
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 ArchiveEntry::ArchiveEntry()
@@ -29,6 +33,10 @@ CArchiveLoader::CArchiveLoader(std::string _mountPoint, boost::filesystem::path
     mountPoint(std::move(_mountPoint)),
 	extractArchives(_extractArchives)
 {
+	// extraction requires reading all entries anyway
+	if(!extractArchives && restoreIndex())
+		return;
+
 	// Open archive file(.snd, .vid, .lod)
 	CFileInputStream fileStream(archive);
 
@@ -50,6 +58,64 @@ CArchiveLoader::CArchiveLoader(std::string _mountPoint, boost::filesystem::path
 		throw std::runtime_error("LOD archive format unknown. Cannot deal with " + archive.string());
 
 	logGlobal->trace("%sArchive \"%s\" loaded (%d files found).", ext, archive.filename(), entries.size());
+
+	if(!extractArchives)
+		storeIndex();
+}
+
+std::string CArchiveLoader::getIndexKey() const
+{
+	return "archive|" + mountPoint + "|" + archive.string();
+}
+
+bool CArchiveLoader::restoreIndex()
+{
+	JsonNode index = ResourceIndexCache::load(getIndexKey());
+	if(index.isNull())
+		return false;
+
+	boost::system::error_code ec;
+	auto size = boost::filesystem::file_size(archive, ec);
+	if(ec || index["size"].Integer() != static_cast<si64>(size) || index["modified"].Integer() != ResourceIndexCache::getModificationTime(archive))
+		return false;
+
+	for(const auto & node : index["entries"].Vector())
+	{
+		ArchiveEntry entry;
+		entry.name = node[0].String();
+		entry.offset = node[1].Integer();
+		entry.fullSize = node[2].Integer();
+		entry.compressedSize = node[3].Integer();
+		entries[ResourcePath(mountPoint + entry.name)] = entry;
+	}
+
+	logGlobal->trace("Archive \"%s\" restored from index (%d files found).", archive.filename(), entries.size());
+	return true;
+}
+
+void CArchiveLoader::storeIndex() const
+{
+	boost::system::error_code ec;
+	auto size = boost::filesystem::file_size(archive, ec);
+	std::time_t modified = ResourceIndexCache::getModificationTime(archive);
+	if(ec || modified == 0)
+		return;
+
+	JsonNode index;
+	index["size"].Integer() = size;
+	index["modified"].Integer() = modified;
+
+	for(const auto & entry : entries)
+	{
+		JsonNode node;
+		node.Vector().emplace_back(entry.second.name);
+		node.Vector().emplace_back(static_cast<si64>(entry.second.offset));
+		node.Vector().emplace_back(static_cast<si64>(entry.second.fullSize));
+		node.Vector().emplace_back(static_cast<si64>(entry.second.compressedSize));
+		index["entries"].Vector().push_back(std::move(node));
+	}
+
+	ResourceIndexCache::save(getIndexKey(), index);
 }
 
 void CArchiveLoader::initLODArchive(const std::string &mountPoint, CFileInputStream & fileStream)
@@ -177,14 +243,33 @@ std::unique_ptr<CInputStream> CArchiveLoader::load(const ResourcePath & resource
 
 	if (entry.compressedSize != 0) //compressed data
 	{
-		auto fileStream = std::make_unique<CFileInputStream>(archive, entry.offset, entry.compressedSize);
+		auto fileStream = openArchiveStream(entry.offset, entry.compressedSize);
 
 		return std::make_unique<CCompressedStream>(std::move(fileStream), false, entry.fullSize);
 	}
 	else
 	{
-		return std::make_unique<CFileInputStream>(archive, entry.offset, entry.fullSize);
+		return openArchiveStream(entry.offset, entry.fullSize);
+	}
+}
+
+std::unique_ptr<CInputStream> CArchiveLoader::openArchiveStream(si64 start, si64 size) const
+{
+	// only range of requested entry is mapped, and only for as long as its stream exists
+	// mapping whole archive would permanently take large part of address space on 32-bit systems
+	if (CMappedFile::isEnabled() && size >= CMappedFile::minimalMappedSize)
+	{
+		try
+		{
+			return std::make_unique<CMappedFileStream>(std::make_shared<CMappedFile>(archive, start, size));
+		}
+		catch (const std::exception & e)
+		{
+			logGlobal->warn("Failed to map part of archive %s into memory: %s", archive.string(), e.what());
+		}
 	}
+
+	return std::make_unique<CFileInputStream>(archive, start, size);
 }
 
 bool CArchiveLoader::existsResource(const ResourcePath & resourceName) const
@@ -93,6 +93,25 @@ private:
 	 */
 	void initSNDArchive(const std::string &mountPoint, CFileInputStream & fileStream);
 
+	/** Returns key that identifies index of this archive in resource index cache */
+	std::string getIndexKey() const;
+
+	/**
+	 * Restores list of entries from resource index cache
+	 *
+	 * @return true if index was found and archive has same size and modification time as when index was stored
+	 */
+	bool restoreIndex();
+
+	/** Stores list of entries, together with size and modification time of archive, in resource index cache */
+	void storeIndex() const;
+
+	/**
+	 * Creates stream for reading part of the archive.
+	 * Reads directly from memory-mapped part of archive if possible, with fallback to file stream
+	 */
+	std::unique_ptr<CInputStream> openArchiveStream(si64 start, si64 size) const;
+
 	/** The file path to the archive which is scanned and indexed. */
 	boost::filesystem::path archive;
 
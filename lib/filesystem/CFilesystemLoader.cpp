@@ -11,18 +11,44 @@
 #include "CFilesystemLoader.h"
 
 #include "CFileInputStream.h"
+#include "ResourceIndexCache.h"
 
 #include "../ExceptionsCommon.h"
+#include "../json/JsonNode.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+static std::string makeResourceName(const std::string & mountPoint, const boost::filesystem::path & filename)
+{
+	std::string resName;
+	if (boost::filesystem::path::preferred_separator != '/')
+	{
+		// resource names are using UNIX slashes (/)
+		resName.reserve(mountPoint.size() + filename.native().size());
+		resName = mountPoint;
+		for (const char c : filename.string())
+			if (c != boost::filesystem::path::preferred_separator)
+				resName.push_back(c);
+			else
+				resName.push_back('/');
+	}
+	else
+		resName = mountPoint + filename.string();
+
+	return resName;
+}
+
 CFilesystemLoader::CFilesystemLoader(std::string _mountPoint, boost::filesystem::path baseDirectory, size_t depth, bool initial):
 	baseDirectory(std::move(baseDirectory)),
 	mountPoint(std::move(_mountPoint)),
 	recursiveDepth(depth)
 {
 	try {
-		fileList = listFiles(mountPoint, depth, initial);
+		if (!restoreIndex(initial))
+		{
+			fileList = listFiles(mountPoint, depth, initial);
+			storeIndex(initial);
+		}
 	}
 	catch (const boost::filesystem::filesystem_error & e) {
 		throw DataLoadingException("Failed to load content of '" + baseDirectory.string() + "'. Reason: " + e.what());
@@ -108,6 +134,88 @@ bool CFilesystemLoader::createResource(const std::string & requestedFilename, bo
 	return true;
 }
 
+std::string CFilesystemLoader::getIndexKey(bool initial) const
+{
+	return boost::str(boost::format("directory|%s|%s|%d|%d") % mountPoint % baseDirectory.string() % recursiveDepth % initial);
+}
+
+bool CFilesystemLoader::restoreIndex(bool initial)
+{
+	JsonNode index = ResourceIndexCache::load(getIndexKey(initial));
+	if (index.isNull())
+		return false;
+
+	// any added, removed or renamed file changes modification time of its directory
+	for (const auto & directory : index["directories"].Vector())
+	{
+		if (!directory["modified"].isNull() && ResourceIndexCache::getModificationTime(baseDirectory / directory["path"].String()) != directory["modified"].Integer())
+			return false;
+	}
+
+	for (const auto & directory : index["directories"].Vector())
+	{
+		boost::filesystem::path filename(directory["path"].String());
+		if (!filename.empty())
+			fileList[ResourcePath(makeResourceName(mountPoint, filename), EResType::DIRECTORY)] = filename;
+	}
+
+	for (const auto & file : index["files"].Vector())
+	{
+		boost::filesystem::path filename(file.String());
+		EResType type = EResTypeHelper::getTypeFromExtension(filename.extension().string());
+		fileList[ResourcePath(makeResourceName(mountPoint, filename), type)] = filename;
+	}
+
+	logGlobal->trace("Restored index of %s, %d files", baseDirectory.string(), fileList.size());
+	return true;
+}
+
+void CFilesystemLoader::storeIndex(bool initial) const
+{
+	if(!boost::filesystem::is_directory(baseDirectory))
+		return;
+
+	// timestamps have limited precision - changes made right after directory modification may remain undetected
+	static constexpr std::time_t minimalIndexAge = 2;
+	std::time_t latestAllowedTime = std::time(nullptr) - minimalIndexAge;
+
+	JsonNode index;
+	auto addDirectory = [&](const boost::filesystem::path & filename)
+	{
+		JsonNode entry;
+		entry["path"].String() = filename.string();
+
+		// content of directories beyond depth limit is not part of index
+		if (static_cast<size_t>(std::distance(filename.begin(), filename.end())) > recursiveDepth)
+		{
+			index["directories"].Vector().push_back(std::move(entry));
+			return true;
+		}
+
+		std::time_t modified = ResourceIndexCache::getModificationTime(baseDirectory / filename);
+		entry["modified"].Integer() = modified;
+		index["directories"].Vector().push_back(std::move(entry));
+
+		return modified != 0 && modified <= latestAllowedTime;
+	};
+
+	if (!addDirectory(boost::filesystem::path()))
+		return;
+
+	for (const auto & file : fileList)
+	{
+		if (file.first.getType() == EResType::DIRECTORY)
+		{
+			if (!addDirectory(file.second))
+				return;
+		}
+		else
+			index["files"].Vector().emplace_back(file.second.string());
+	}
+
+	ResourceIndexCache::save(getIndexKey(initial), index);
+}
+
 std::unordered_map<ResourcePath, boost::filesystem::path> CFilesystemLoader::listFiles(const std::string &mountPoint, size_t depth, bool initial) const
 {
 	static const EResType initArray[] = {
@@ -172,22 +280,7 @@ std::unordered_map<ResourcePath, boost::filesystem::path> CFilesystemLoader::lis
 			else
 				filename = it->path().filename();
 
-			std::string resName;
-			if (boost::filesystem::path::preferred_separator != '/')
-			{
-				// resource names are using UNIX slashes (/)
-				resName.reserve(resName.size() + filename.native().size());
-				resName = mountPoint;
-				for (const char c : filename.string())
-					if (c != boost::filesystem::path::preferred_separator)
-						resName.push_back(c);
-					else
-						resName.push_back('/');
-			}
-			else
-				resName = mountPoint + filename.string();
-
-			fileList[ResourcePath(resName, type)] = std::move(filename);
+			fileList[ResourcePath(makeResourceName(mountPoint, filename), type)] = std::move(filename);
 		}
 	}
 
@@ -66,6 +66,19 @@ private:
 	 * The array will be empty if the directory is empty. Ptr is null if the directory doesn't exist or if it isn't a directory.
 	 */
 	std::unordered_map<ResourcePath, boost::filesystem::path> listFiles(const std::string &mountPoint, size_t depth, bool initial) const;
+
+	/** Returns key that identifies index of this directory in resource index cache */
+	std::string getIndexKey(bool initial) const;
+
+	/**
+	 * Restores list of files from resource index cache
+	 *
+	 * @return true if index was found and none of directories were modified since it was stored
+	 */
+	bool restoreIndex(bool initial);
+
+	/** Stores current list of files, together with modification times of all directories, in resource index cache */
+	void storeIndex(bool initial) const;
 };
 
 VCMI_LIB_NAMESPACE_END
@@ -37,6 +37,13 @@ public:
 	{
 		std::unique_ptr<ui8[]> data(new ui8[getSize()]);
 
+		auto span = getSpan();
+		if (span.first)
+		{
+			std::copy_n(span.first, span.second, data.get());
+			return std::make_pair(std::move(data), span.second);
+		}
+
 		seek(0);
 		[[maybe_unused]] auto readSize = read(data.get(), getSize());
 		assert(readSize == getSize());
@@ -44,6 +51,17 @@ public:
 		return std::make_pair(std::move(data), getSize());
 	}
 
+	/**
+	 * @brief provides direct access to whole content of the stream, if stream is backed by memory
+	 * Returned pointer remains valid for as long as stream exists
+	 *
+	 * @return pair, first = pointer to data or nullptr if stream does not supports direct access, second = size of data
+	 */
+	virtual std::pair<const ui8 *, si64> getSpan()
+	{
+		return std::make_pair(nullptr, 0);
+	}
+
 	/**
 	 * @brief calculateCRC32 calculates CRC32 checksum for the whole file
 	 * @return calculated checksum
@@ -53,6 +71,13 @@ public:
 		si64 originalPos = tell();
 
 		boost::crc_32_type checksum;
+		auto span = getSpan();
+		if (span.first)
+		{
+			checksum.process_bytes(span.first, span.second);
+			return checksum.checksum();
+		}
+
 		auto data = readAll();
 		checksum.process_bytes(reinterpret_cast<const void *>(data.first.get()), data.second);
 
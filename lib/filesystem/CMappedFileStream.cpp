@@ -0,0 +1,118 @@
+/*
+ * CMappedFileStream.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "CMappedFileStream.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+static std::atomic<bool> mappingEnabled = true;
+
+CMappedFile::CMappedFile(const boost::filesystem::path & file):
+	CMappedFile(file, 0, boost::filesystem::file_size(file))
+{
+}
+
+CMappedFile::CMappedFile(const boost::filesystem::path & file, si64 offset, si64 size):
+	data(nullptr),
+	size(size)
+{
+	// empty files can't be mapped
+	if (size == 0)
+		return;
+
+	// accessing mapped memory beyond end of file is not handled gracefully by operating system
+	if (offset + size > static_cast<si64>(boost::filesystem::file_size(file)))
+		throw std::runtime_error("Mapped part is beyond end of file!");
+
+	boost::interprocess::file_mapping mapping(file.c_str(), boost::interprocess::read_only);
+	region = std::make_unique<boost::interprocess::mapped_region>(mapping, boost::interprocess::read_only, offset, size);
+	data = static_cast<const ui8 *>(region->get_address());
+	this->size = region->get_size();
+}
+
+CMappedFile::~CMappedFile() = default;
+
+const ui8 * CMappedFile::getData() const
+{
+	return data;
+}
+
+si64 CMappedFile::getSize() const
+{
+	return size;
+}
+
+bool CMappedFile::isEnabled()
+{
+	return mappingEnabled;
+}
+
+void CMappedFile::setEnabled(bool enabled)
+{
+	mappingEnabled = enabled;
+}
+
+CMappedFileStream::CMappedFileStream(std::shared_ptr<const CMappedFile> file, si64 start, si64 size):
+	file(std::move(file)),
+	data(nullptr),
+	dataSize(0),
+	position(0)
+{
+	si64 fileSize = this->file->getSize();
+
+	if (start > fileSize)
+		throw std::runtime_error("Offset of mapped data is beyond end of file!");
+
+	dataSize = size == 0 ? fileSize - start : std::min(size, fileSize - start);
+	if (dataSize != 0)
+		data = this->file->getData() + start;
+}
+
+si64 CMappedFileStream::read(ui8 * buffer, si64 size)
+{
+	si64 toRead = std::min(dataSize - position, size);
+	if (toRead > 0)
+		std::copy_n(data + position, toRead, buffer);
+	position += toRead;
+	return toRead;
+}
+
+si64 CMappedFileStream::seek(si64 newPosition)
+{
+	position = std::clamp<si64>(newPosition, 0, dataSize);
+	return position;
+}
+
+si64 CMappedFileStream::tell()
+{
+	return position;
+}
+
+si64 CMappedFileStream::skip(si64 delta)
+{
+	si64 oldPosition = position;
+	position = std::clamp<si64>(position + delta, 0, dataSize);
+	return position - oldPosition;
+}
+
+si64 CMappedFileStream::getSize()
+{
+	return dataSize;
+}
+
+std::pair<const ui8 *, si64> CMappedFileStream::getSpan()
+{
+	return { data, dataSize };
+}
+
+VCMI_LIB_NAMESPACE_END
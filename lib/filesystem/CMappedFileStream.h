@@ -0,0 +1,140 @@
+/*
+ * CMappedFileStream.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "CInputStream.h"
+
+namespace boost::interprocess
+{
+class mapped_region;
+}
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/**
+ * A file, or part of it, that is mapped into memory.
+ * Shared between all streams that read from it, mapping is released once last stream is destroyed
+ */
+class DLL_LINKAGE CMappedFile : boost::noncopyable
+{
+public:
+	/** Mapping has fixed setup cost, for smaller data plain reading is faster */
+	static constexpr si64 minimalMappedSize = 16 * 1024;
+
+	/**
+	 * C-tor. Maps the specified file into memory.
+	 *
+	 * @param file Path to the file.
+	 *
+	 * @throws std::exception if file wasn't found or can't be mapped
+	 */
+	explicit CMappedFile(const boost::filesystem::path & file);
+
+	/**
+	 * C-tor. Maps part of the specified file into memory.
+	 *
+	 * @param file Path to the file.
+	 * @param offset Offset of mapped part from file start
+	 * @param size Size of mapped part
+	 *
+	 * @throws std::exception if file wasn't found, can't be mapped or is smaller than requested part
+	 */
+	CMappedFile(const boost::filesystem::path & file, si64 offset, si64 size);
+	~CMappedFile();
+
+	/** Returns pointer to mapped content of the file or nullptr if it is empty */
+	const ui8 * getData() const;
+
+	/** Returns size of mapped content in bytes */
+	si64 getSize() const;
+
+	/** Returns true if resource loaders should use memory mapping when possible */
+	static bool isEnabled();
+
+	/** Enables or disables memory mapping in resource loaders, for example to compare it with plain file reading */
+	static void setEnabled(bool enabled);
+
+private:
+	std::unique_ptr<boost::interprocess::mapped_region> region;
+	const ui8 * data;
+	si64 size;
+};
+
+/**
+ * A class which provides method definitions for reading a file, or part of it, directly from memory-mapped file.
+ */
+class DLL_LINKAGE CMappedFileStream : public CInputStream
+{
+public:
+	/**
+	 * C-tor.
+	 *
+	 * @param file Mapped file to read from
+	 * @param start - offset from file start where real data starts (e.g file on archive)
+	 * @param size - size of real data in file (e.g file on archive) or 0 to use whole file
+	 */
+	CMappedFileStream(std::shared_ptr<const CMappedFile> file, si64 start = 0, si64 size = 0);
+
+	/**
+	 * Reads n bytes from the stream into the data buffer.
+	 *
+	 * @param data A pointer to the destination data array.
+	 * @param size The number of bytes to read.
+	 * @return the number of bytes read actually.
+	 */
+	si64 read(ui8 * data, si64 size) override;
+
+	/**
+	 * Seeks the internal read pointer to the specified position.
+	 *
+	 * @param position The read position from the beginning.
+	 * @return the position actually moved to, -1 on error.
+	 */
+	si64 seek(si64 position) override;
+
+	/**
+	 * Gets the current read position in the stream.
+	 *
+	 * @return the read position.
+	 */
+	si64 tell() override;
+
+	/**
+	 * Skips delta numbers of bytes.
+	 *
+	 * @param delta The count of bytes to skip.
+	 * @return the count of bytes skipped actually.
+	 */
+	si64 skip(si64 delta) override;
+
+	/**
+	 * Gets the length in bytes of the stream.
+	 *
+	 * @return the length in bytes of the stream.
+	 */
+	si64 getSize() override;
+
+	/**
+	 * Returns pointer to mapped data of this stream without copying it
+	 *
+	 * @return pair, first = pointer to data, second = size of data
+	 */
+	std::pair<const ui8 *, si64> getSpan() override;
+
+private:
+	/** Keeps file mapped for as long as this stream exists */
+	std::shared_ptr<const CMappedFile> file;
+
+	const ui8 * data;
+	si64 dataSize;
+	si64 position;
+};
+
+VCMI_LIB_NAMESPACE_END
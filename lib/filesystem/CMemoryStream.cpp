@@ -50,4 +50,9 @@ si64 CMemoryStream::getSize()
 	return size;
 }
 
+std::pair<const ui8 *, si64> CMemoryStream::getSpan()
+{
+	return std::make_pair(data, size);
+}
+
 VCMI_LIB_NAMESPACE_END
@@ -67,6 +67,13 @@ public:
 	 */
 	si64 getSize() override;
 
+	/**
+	 * Returns pointer to the data array of this stream.
+	 *
+	 * @return pair, first = pointer to data, second = size of data
+	 */
+	std::pair<const ui8 *, si64> getSpan() override;
+
 private:
 	/** A pointer to the data array. */
 	const ui8 * data;
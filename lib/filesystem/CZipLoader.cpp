@@ -61,9 +61,9 @@ CZipLoader::CZipLoader(const std::string & mountPoint, const boost::filesystem::
 	logGlobal->trace("Zip archive loaded, %d files found", files.size());
 }
 
-std::unordered_map<ResourcePath, unz64_file_pos> CZipLoader::listFiles(const std::string & mountPoint, const boost::filesystem::path & archive)
+std::unordered_map<ResourcePath, CZipLoader::ZipEntry> CZipLoader::listFiles(const std::string & mountPoint, const boost::filesystem::path & archive)
 {
-	std::unordered_map<ResourcePath, unz64_file_pos> ret;
+	std::unordered_map<ResourcePath, ZipEntry> ret;
 
 	unzFile file = unzOpen2_64(archive.c_str(), &zlibApi);
 
@@ -84,7 +84,9 @@ std::unordered_map<ResourcePath, unz64_file_pos> CZipLoader::listFiles(const std
 			unzGetCurrentFileInfo64(file, &info, filename.data(), static_cast<uLong>(filename.size()), nullptr, 0, nullptr, 0);
 
 			std::string filenameString(filename.data(), filename.size());
-			unzGetFilePos64(file, &ret[ResourcePath(mountPoint + filenameString)]);
+			ZipEntry & entry = ret[ResourcePath(mountPoint + filenameString)];
+			unzGetFilePos64(file, &entry.position);
+			entry.checksum = info.crc;
 		}
 		while (unzGoToNextFile(file) == UNZ_OK);
 	}
@@ -95,7 +97,7 @@ std::unordered_map<ResourcePath, unz64_file_pos> CZipLoader::listFiles(const std
 
 std::unique_ptr<CInputStream> CZipLoader::load(const ResourcePath & resourceName) const
 {
-	return std::unique_ptr<CInputStream>(new CZipStream(ioApi, archiveName, files.at(resourceName)));
+	return std::unique_ptr<CInputStream>(new CZipStream(ioApi, archiveName, files.at(resourceName).position));
 }
 
 bool CZipLoader::existsResource(const ResourcePath & resourceName) const
@@ -108,6 +110,11 @@ std::string CZipLoader::getMountPoint() const
 	return mountPoint;
 }
 
+std::optional<ui32> CZipLoader::getResourceChecksum(const ResourcePath & resourceName) const
+{
+	return files.at(resourceName).checksum;
+}
+
 std::unordered_set<ResourcePath> CZipLoader::getFilteredFiles(std::function<bool(const ResourcePath &)> filter) const
 {
 	std::unordered_set<ResourcePath> foundID;
@@ -46,9 +46,16 @@ class DLL_LINKAGE CZipLoader : public ISimpleResourceLoader
 	boost::filesystem::path archiveName;
 	std::string mountPoint;
 
-	std::unordered_map<ResourcePath, unz64_file_pos> files;
+	struct ZipEntry
+	{
+		unz64_file_pos position;
+		/// crc32 of uncompressed file, as stored in central directory of archive
+		ui32 checksum;
+	};
 
-	std::unordered_map<ResourcePath, unz64_file_pos> listFiles(const std::string & mountPoint, const boost::filesystem::path &archive);
+	std::unordered_map<ResourcePath, ZipEntry> files;
+
+	std::unordered_map<ResourcePath, ZipEntry> listFiles(const std::string & mountPoint, const boost::filesystem::path &archive);
 public:
 	CZipLoader(const std::string & mountPoint, const boost::filesystem::path & archive, std::shared_ptr<CIOApi> api = std::make_shared<CDefaultIOApi>());
 
@@ -57,6 +64,7 @@ public:
 	std::unique_ptr<CInputStream> load(const ResourcePath & resourceName) const override;
 	bool existsResource(const ResourcePath & resourceName) const override;
 	std::string getMountPoint() const override;
+	std::optional<ui32> getResourceChecksum(const ResourcePath & resourceName) const override;
 	void updateFilteredFiles(std::function<bool(const std::string &)> filter) const override {}
 	std::unordered_set<ResourcePath> getFilteredFiles(std::function<bool(const ResourcePath &)> filter) const override;
 };
@@ -0,0 +1,117 @@
+/*
+ * FileChecksumCache.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "FileChecksumCache.h"
+
+#include "../json/JsonNode.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+FileChecksumCache::FileChecksumCache(const boost::filesystem::path & stampFile)
+	: stampFile(stampFile)
+{
+	boost::filesystem::ifstream file(stampFile, std::ios::binary);
+	if(!file)
+		return;
+
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	JsonNode config(reinterpret_cast<const std::byte *>(data.data()), data.size(), stampFile.string());
+
+	for(const auto & entry : config.Struct())
+	{
+		FileStamp stamp;
+		stamp.size = entry.second["size"].Integer();
+		stamp.modified = entry.second["modified"].Integer();
+		stamp.checksum = entry.second["checksum"].Integer();
+		storedStamps[entry.first] = stamp;
+	}
+}
+
+ui32 FileChecksumCache::getChecksum(const boost::filesystem::path & file, const std::function<ui32()> & calculator)
+{
+	boost::system::error_code ec;
+	FileStamp stamp;
+	stamp.size = boost::filesystem::file_size(file, ec);
+	if(!ec)
+		stamp.modified = boost::filesystem::last_write_time(file, ec);
+
+	// file can't be checked - do not remember anything about it
+	if(ec)
+		return calculator();
+
+	// modification time has resolution of one second, so file that was modified just now
+	// may be modified again without changing its stamp - do not remember such files
+	if(std::time(nullptr) - stamp.modified < recentModificationSeconds)
+		return calculator();
+
+	std::string key = file.string();
+
+	{
+		std::lock_guard lock(mutex);
+		auto it = storedStamps.find(key);
+		if(it != storedStamps.end() && it->second.size == stamp.size && it->second.modified == stamp.modified)
+		{
+			currentStamps[key] = it->second;
+			return it->second.checksum;
+		}
+	}
+
+	stamp.checksum = calculator();
+
+	std::lock_guard lock(mutex);
+	currentStamps[key] = stamp;
+	changed = true;
+	return stamp.checksum;
+}
+
+void FileChecksumCache::save() const
+{
+	std::lock_guard lock(mutex);
+
+	// if some of stored files are no longer in use, drop them from stamp file as well
+	if(!changed && currentStamps.size() == storedStamps.size())
+		return;
+
+	JsonNode config;
+	for(const auto & entry : currentStamps)
+	{
+		JsonNode & node = config[entry.first];
+		node["size"].Integer() = entry.second.size;
+		node["modified"].Integer() = entry.second.modified;
+		node["checksum"].Integer() = entry.second.checksum;
+	}
+
+	// write into temporary file first, so interrupted write can't leave truncated stamps behind
+	boost::filesystem::path temporaryPath = stampFile;
+	temporaryPath += ".tmp";
+
+	boost::system::error_code ec;
+	{
+		std::ofstream file(temporaryPath.c_str(), std::ofstream::binary | std::ofstream::trunc);
+		file << config.toString();
+
+		if(!file)
+		{
+			logGlobal->warn("Failed to write file checksums into %s", temporaryPath.string());
+			file.close();
+			boost::filesystem::remove(temporaryPath, ec);
+			return;
+		}
+	}
+
+	boost::filesystem::rename(temporaryPath, stampFile, ec);
+	if(ec)
+	{
+		logGlobal->warn("Failed to store file checksums: %s", ec.message());
+		boost::filesystem::remove(temporaryPath, ec);
+	}
+}
+
+VCMI_LIB_NAMESPACE_END
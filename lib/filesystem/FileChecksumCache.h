@@ -0,0 +1,49 @@
+/*
+ * FileChecksumCache.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Remembers checksums of files in filesystem together with their size and modification time
+/// This allows to get checksum of unchanged file without reading its content
+class DLL_LINKAGE FileChecksumCache : boost::noncopyable
+{
+	struct FileStamp
+	{
+		uintmax_t size = 0;
+		std::time_t modified = 0;
+		ui32 checksum = 0;
+	};
+
+	/// files modified less than this number of seconds ago are not remembered
+	static constexpr std::time_t recentModificationSeconds = 2;
+
+	boost::filesystem::path stampFile;
+
+	/// stamps loaded from stamp file
+	std::map<std::string, FileStamp> storedStamps;
+	/// stamps of all files requested since creation, only these will be written back
+	std::map<std::string, FileStamp> currentStamps;
+	bool changed = false;
+
+	mutable std::mutex mutex;
+
+public:
+	explicit FileChecksumCache(const boost::filesystem::path & stampFile);
+
+	/// returns checksum of file, calls calculator only if file is not known or was modified since last check
+	/// thread-safe, calculator is called without lock
+	ui32 getChecksum(const boost::filesystem::path & file, const std::function<ui32()> & calculator);
+
+	/// writes stamps of all requested files into stamp file, if any of them has changed
+	void save() const;
+};
+
+VCMI_LIB_NAMESPACE_END
@@ -54,6 +54,27 @@ public:
 		return std::optional<boost::filesystem::path>();
 	}
 
+	/**
+	 * Gets checksum of resource if it is known without loading resource, e.g. stored in archive
+	 *
+	 * @return crc32 of resource content or empty optional if resource needs to be loaded to calculate it
+	 */
+	virtual std::optional<ui32> getResourceChecksum(const ResourcePath & resourceName) const
+	{
+		return std::nullopt;
+	}
+
+	/**
+	 * Starts loading and unpacking of resources on background threads.
+	 * Loaded data is kept in memory, so following calls to load() for these resources don't need to wait for I/O or decompression.
+	 * Prefetched data is bounded in size, resources that are not requested in time may be dropped
+	 *
+	 * @param resources list of resources that are likely to be loaded soon
+	 */
+	virtual void prefetch(const std::vector<ResourcePath> & resources) const
+	{
+	}
+
 	/**
 	 * Gets all full names of matching resources, e.g. names of files in filesystem.
 	 *
@@ -0,0 +1,93 @@
+/*
+ * ResourceIndexCache.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "ResourceIndexCache.h"
+
+#include "../VCMIDirs.h"
+#include "../json/JsonNode.h"
+#include "../texts/TextOperations.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+static boost::filesystem::path getIndexPath(const std::string & key)
+{
+	boost::crc_32_type checksum;
+	checksum.process_bytes(key.data(), key.size());
+
+	return VCMIDirs::get().userCachePath() / "resourceIndex" / (boost::str(boost::format("%08x") % checksum.checksum()) + ".json");
+}
+
+JsonNode ResourceIndexCache::load(const std::string & key)
+{
+	boost::filesystem::ifstream file(getIndexPath(key), std::ios::binary);
+	if(!file)
+		return JsonNode();
+
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	JsonNode index(reinterpret_cast<const std::byte *>(data.data()), data.size(), key);
+
+	// different mount with same checksum of key
+	if(index["key"].String() != key)
+		return JsonNode();
+
+	return index;
+}
+
+void ResourceIndexCache::save(const std::string & key, const JsonNode & index)
+{
+	auto path = getIndexPath(key);
+
+	JsonNode stored = index;
+	stored["key"].String() = key;
+	std::string data = stored.toCompactString();
+
+	// file names in non-unicode encoding can't be restored from json
+	if(!TextOperations::isValidUnicodeString(data))
+	{
+		logGlobal->trace("Index of %s contains non-unicode names and won't be stored", key);
+		return;
+	}
+
+	// write into temporary file first, so interrupted write can't leave truncated index behind
+	boost::filesystem::path temporaryPath = path;
+	temporaryPath += ".tmp";
+
+	boost::system::error_code ec;
+	boost::filesystem::create_directories(path.parent_path(), ec);
+
+	{
+		std::ofstream file(temporaryPath.c_str(), std::ofstream::binary | std::ofstream::trunc);
+		file << data;
+
+		if(!file)
+		{
+			logGlobal->warn("Failed to write index of %s", key);
+			file.close();
+			boost::filesystem::remove(temporaryPath, ec);
+			return;
+		}
+	}
+
+	boost::filesystem::rename(temporaryPath, path, ec);
+	if(ec)
+	{
+		logGlobal->warn("Failed to store index of %s: %s", key, ec.message());
+		boost::filesystem::remove(temporaryPath, ec);
+	}
+}
+
+std::time_t ResourceIndexCache::getModificationTime(const boost::filesystem::path & path)
+{
+	boost::system::error_code ec;
+	auto result = boost::filesystem::last_write_time(path, ec);
+	return ec ? 0 : result;
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,31 @@
+/*
+ * ResourceIndexCache.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+class JsonNode;
+
+/// On-disk storage for lists of files in mounted directories and archives
+/// Each mount is stored in separate file in user cache directory, so unchanged mounts can be restored without scanning them again
+/// Validation of stored index is responsibility of the loader that uses it
+namespace ResourceIndexCache
+{
+	/// returns index stored for mount with specified key or null node if there is none
+	DLL_LINKAGE JsonNode load(const std::string & key);
+
+	/// stores index of mount with specified key, replacing previous one
+	DLL_LINKAGE void save(const std::string & key, const JsonNode & index);
+
+	/// returns modification time of file or directory, or 0 if it can't be determined
+	DLL_LINKAGE std::time_t getModificationTime(const boost::filesystem::path & path);
+}
+
+VCMI_LIB_NAMESPACE_END
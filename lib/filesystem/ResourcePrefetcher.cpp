@@ -0,0 +1,174 @@
+/*
+ * ResourcePrefetcher.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "ResourcePrefetcher.h"
+
+#include "CMemoryStream.h"
+#include "ISimpleResourceLoader.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Memory stream that keeps prefetched data alive for as long as stream exists
+class CPrefetchedStream : public CMemoryStream
+{
+	std::shared_ptr<const void> owner;
+
+public:
+	CPrefetchedStream(std::shared_ptr<const void> owner, const ui8 * data, si64 size)
+		: CMemoryStream(data, size)
+		, owner(std::move(owner))
+	{
+	}
+};
+
+ResourcePrefetcher::~ResourcePrefetcher()
+{
+	tasks.wait();
+}
+
+void ResourcePrefetcher::prefetch(const ResourcePath & resource, const ISimpleResourceLoader * loader)
+{
+	uint64_t order;
+	{
+		std::lock_guard lock(mutex);
+
+		auto it = entries.find(resource);
+		if(it != entries.end() && it->second.loader == loader)
+			return;
+
+		// resource is now provided by another loader - previously prefetched data is outdated
+		if(it != entries.end() && it->second.data)
+			cachedSize -= it->second.data->size;
+
+		order = nextOrder++;
+		entries[resource] = Entry{loader, nullptr, order};
+		entriesCount = entries.size();
+	}
+
+	tasks.run([this, resource, loader, order]()
+	{
+		if(!startLoading(resource, order))
+			return;
+
+		try
+		{
+			auto result = std::make_shared<PrefetchedData>();
+			std::tie(result->data, result->size) = loader->load(resource)->readAll();
+			storeResult(resource, order, std::move(result));
+		}
+		catch(const std::exception & e)
+		{
+			logGlobal->warn("Failed to prefetch resource %s: %s", resource.getOriginalName(), e.what());
+			storeResult(resource, order, nullptr);
+		}
+	});
+}
+
+bool ResourcePrefetcher::startLoading(const ResourcePath & resource, uint64_t order)
+{
+	std::lock_guard lock(mutex);
+
+	// entry was already requested or dropped before loading has started
+	auto it = entries.find(resource);
+	if(it == entries.end() || it->second.order != order)
+		return false;
+
+	it->second.started = true;
+	return true;
+}
+
+void ResourcePrefetcher::storeResult(const ResourcePath & resource, uint64_t order, std::shared_ptr<const PrefetchedData> data)
+{
+	std::lock_guard lock(mutex);
+	resultStored.notify_all();
+
+	// entry was already requested, replaced or dropped while loading
+	auto it = entries.find(resource);
+	if(it == entries.end() || it->second.order != order)
+		return;
+
+	if(!data)
+	{
+		entries.erase(it);
+		entriesCount = entries.size();
+		return;
+	}
+
+	cachedSize += data->size;
+	it->second.data = std::move(data);
+
+	while(cachedSize > maximalCacheSize)
+		evictOldest();
+}
+
+void ResourcePrefetcher::evictOldest()
+{
+	auto oldest = entries.end();
+	for(auto it = entries.begin(); it != entries.end(); ++it)
+	{
+		if(it->second.data && (oldest == entries.end() || it->second.order < oldest->second.order))
+			oldest = it;
+	}
+
+	assert(oldest != entries.end());
+	cachedSize -= oldest->second.data->size;
+	entries.erase(oldest);
+	entriesCount = entries.size();
+}
+
+std::unique_ptr<CInputStream> ResourcePrefetcher::take(const ResourcePath & resource, const ISimpleResourceLoader * loader)
+{
+	if(entriesCount == 0)
+		return nullptr;
+
+	std::unique_lock lock(mutex);
+
+	auto it = entries.find(resource);
+	if(it == entries.end() || it->second.loader != loader)
+		return nullptr;
+
+	uint64_t order = it->second.order;
+
+	// loading is in progress - waiting for it is faster than loading resource again
+	if(it->second.started && !it->second.data)
+	{
+		resultStored.wait(lock, [&]()
+		{
+			it = entries.find(resource);
+			return it == entries.end() || it->second.order != order || it->second.data;
+		});
+
+		if(it == entries.end() || it->second.order != order)
+			return nullptr;
+	}
+
+	// if loading has not started yet, drop entry and let caller load resource directly
+	auto data = it->second.data;
+	entries.erase(it);
+	entriesCount = entries.size();
+
+	if(!data)
+		return nullptr;
+
+	cachedSize -= data->size;
+	return std::make_unique<CPrefetchedStream>(data, data->data.get(), data->size);
+}
+
+void ResourcePrefetcher::clear()
+{
+	tasks.wait();
+
+	std::lock_guard lock(mutex);
+	entries.clear();
+	entriesCount = 0;
+	cachedSize = 0;
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,75 @@
+/*
+ * ResourcePrefetcher.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "ResourcePath.h"
+
+#include <condition_variable>
+
+#include <tbb/task_group.h>
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+class CInputStream;
+class ISimpleResourceLoader;
+
+/// Loads and unpacks resources on background threads and keeps them in memory until they are requested
+/// Each prefetched resource is handed out only once, so resources that are modified later are never returned outdated
+class ResourcePrefetcher : boost::noncopyable
+{
+	struct PrefetchedData
+	{
+		std::unique_ptr<ui8[]> data;
+		si64 size = 0;
+	};
+
+	struct Entry
+	{
+		/// loader that will provide this resource, used to detect overridden resources
+		const ISimpleResourceLoader * loader = nullptr;
+		/// loaded data, or nullptr if resource is still being loaded
+		std::shared_ptr<const PrefetchedData> data;
+		/// order of prefetch requests, oldest entries are evicted first
+		uint64_t order = 0;
+		/// true if background thread has started loading this resource
+		bool started = false;
+	};
+
+	/// total size of data that can be kept in memory at once
+	static constexpr si64 maximalCacheSize = 64 * 1024 * 1024;
+
+	std::unordered_map<ResourcePath, Entry> entries;
+	std::atomic<size_t> entriesCount = 0;
+	si64 cachedSize = 0;
+	uint64_t nextOrder = 0;
+	std::mutex mutex;
+	std::condition_variable resultStored;
+
+	tbb::task_group tasks;
+
+	bool startLoading(const ResourcePath & resource, uint64_t order);
+	void storeResult(const ResourcePath & resource, uint64_t order, std::shared_ptr<const PrefetchedData> data);
+	void evictOldest();
+
+public:
+	~ResourcePrefetcher();
+
+	/// starts loading of resource from specified loader on background thread
+	void prefetch(const ResourcePath & resource, const ISimpleResourceLoader * loader);
+
+	/// returns stream with prefetched resource and removes it from cache, waiting for loading to finish if it is already in progress
+	/// returns nullptr if resource was not prefetched from this loader or its loading has not started yet
+	std::unique_ptr<CInputStream> take(const ResourcePath & resource, const ISimpleResourceLoader * loader);
+
+	/// waits for all background loading and drops all prefetched resources
+	void clear();
+};
+
+VCMI_LIB_NAMESPACE_END
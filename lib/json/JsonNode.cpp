@@ -48,6 +48,25 @@ VCMI_LIB_NAMESPACE_BEGIN
 
 static const JsonNode nullNode;
 
+/// Parses content of stream, directly from memory if stream allows it
+static JsonNode parseStream(CInputStream & stream, const std::string & fileName, const JsonParsingSettings & parserSettings, bool & isValidSyntax)
+{
+	auto span = stream.getSpan();
+	std::unique_ptr<ui8[]> buffer;
+
+	if(span.first == nullptr)
+	{
+		auto file = stream.readAll();
+		buffer = std::move(file.first);
+		span = std::make_pair(buffer.get(), file.second);
+	}
+
+	JsonParser parser(reinterpret_cast<const std::byte *>(span.first), span.second, parserSettings);
+	JsonNode result = parser.parse(fileName);
+	isValidSyntax = parser.isValid();
+	return result;
+}
+
 class LibClasses;
 class CModHandler;
 
@@ -104,27 +123,19 @@ JsonNode::JsonNode(const JsonPath & fileURI)
 
 JsonNode::JsonNode(const JsonPath & fileURI, const JsonParsingSettings & parserSettings)
 {
-	auto file = CResourceHandler::get()->load(fileURI)->readAll();
-
-	JsonParser parser(reinterpret_cast<std::byte *>(file.first.get()), file.second, parserSettings);
-	*this = parser.parse(fileURI.getName());
+	bool isValidSyntax;
+	*this = parseStream(*CResourceHandler::get()->load(fileURI), fileURI.getName(), parserSettings, isValidSyntax);
 }
 
 JsonNode::JsonNode(const JsonPath & fileURI, const std::string & idx)
 {
-	auto file = CResourceHandler::get(idx)->load(fileURI)->readAll();
-
-	JsonParser parser(reinterpret_cast<std::byte *>(file.first.get()), file.second, JsonParsingSettings());
-	*this = parser.parse(fileURI.getName());
+	bool isValidSyntax;
+	*this = parseStream(*CResourceHandler::get(idx)->load(fileURI), fileURI.getName(), JsonParsingSettings(), isValidSyntax);
 }
 
 JsonNode::JsonNode(const JsonPath & fileURI, bool & isValidSyntax)
 {
-	auto file = CResourceHandler::get()->load(fileURI)->readAll();
-
-	JsonParser parser(reinterpret_cast<std::byte *>(file.first.get()), file.second, JsonParsingSettings());
-	*this = parser.parse(fileURI.getName());
-	isValidSyntax = parser.isValid();
+	*this = parseStream(*CResourceHandler::get()->load(fileURI), fileURI.getName(), JsonParsingSettings(), isValidSyntax);
 }
 
 bool JsonNode::operator==(const JsonNode & other) const
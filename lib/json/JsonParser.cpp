@@ -17,6 +17,44 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+// Helpers for scanning input 8 characters at once, using plain 64-bit integer operations
+// Each check returns non-zero if at least one byte in word matches condition
+namespace JsonScan
+{
+	constexpr size_t wordSize = sizeof(uint64_t);
+
+	constexpr uint64_t broadcast(uint8_t value)
+	{
+		return 0x0101010101010101ull * value;
+	}
+
+	static uint64_t loadWord(const char * data)
+	{
+		uint64_t word;
+		std::memcpy(&word, data, wordSize);
+		return word;
+	}
+
+	/// any byte is equal to value
+	static uint64_t hasByte(uint64_t word, uint8_t value)
+	{
+		uint64_t masked = word ^ broadcast(value);
+		return (masked - broadcast(0x01)) & ~masked & broadcast(0x80);
+	}
+
+	/// any byte is less than value, value must not exceed 128
+	static uint64_t hasLess(uint64_t word, uint8_t value)
+	{
+		return (word - broadcast(value)) & ~word & broadcast(0x80);
+	}
+
+	/// any byte is greater than value, value must not exceed 127
+	static uint64_t hasMore(uint64_t word, uint8_t value)
+	{
+		return ((word + broadcast(127 - value)) | word) & broadcast(0x80);
+	}
+}
+
 JsonParser::JsonParser(const std::byte * inputString, size_t stringSize, const JsonParsingSettings & settings)
 	: settings(settings)
 	, input(reinterpret_cast<const char *>(inputString), stringSize)
@@ -118,6 +156,15 @@ bool JsonParser::extractWhitespace(bool verbose)
 
 	while(true)
 	{
+		// skip indentation - blocks of whitespace without line breaks
+		while(pos + JsonScan::wordSize <= input.size())
+		{
+			uint64_t word = JsonScan::loadWord(input.data() + pos);
+			if(JsonScan::hasMore(word, ' ') || JsonScan::hasByte(word, '\n'))
+				break;
+			pos += JsonScan::wordSize;
+		}
+
 		while(pos < input.size() && static_cast<ui8>(input[pos]) <= ' ')
 		{
 			if(input[pos] == '\n')
@@ -142,6 +189,9 @@ bool JsonParser::extractWhitespace(bool verbose)
 		else
 			error("Comments must consist of two slashes!", true);
 
+		while(pos + JsonScan::wordSize <= input.size() && !JsonScan::hasByte(JsonScan::loadWord(input.data() + pos), '\n'))
+			pos += JsonScan::wordSize;
+
 		while(pos < input.size() && input[pos] != '\n')
 			pos++;
 	}
@@ -207,9 +257,27 @@ bool JsonParser::extractString(std::string & str)
 	pos++;
 
 	size_t first = pos;
+	size_t scanEnd = pos;
 
 	while(pos != input.size())
 	{
+		// skip blocks of characters that need no special handling
+		if(pos >= scanEnd)
+		{
+			while(pos + JsonScan::wordSize <= input.size())
+			{
+				uint64_t word = JsonScan::loadWord(input.data() + pos);
+				if(JsonScan::hasByte(word, lineTerminator) || JsonScan::hasByte(word, '\\') || JsonScan::hasLess(word, ' '))
+					break;
+				pos += JsonScan::wordSize;
+			}
+			// this block contains special character - check it byte by byte
+			scanEnd = pos + JsonScan::wordSize;
+
+			if(pos == input.size())
+				break;
+		}
+
 		if(input[pos] == lineTerminator) // Correct end of string
 		{
 			str.append(&input[first], pos - first);
@@ -248,7 +316,7 @@ bool JsonParser::extractString(JsonNode & node)
 		return false;
 
 	node.setType(JsonNode::JsonType::DATA_STRING);
-	node.String() = str;
+	node.String() = std::move(str);
 	return true;
 }
 
@@ -380,16 +448,17 @@ bool JsonParser::extractStruct(JsonNode & node)
 			}
 		}
 
-		if(node.Struct().find(key) != node.Struct().end())
+		auto [element, inserted] = node.Struct().try_emplace(std::move(key));
+		if(!inserted)
 			error("Duplicate element encountered!", true);
 
 		if(!extractSeparator())
 			return false;
 
-		if(!extractElement(node.Struct()[key], '}'))
+		if(!extractElement(element->second, '}'))
 			return false;
 
-		node.Struct()[key].setOverrideFlag(overrideFlag);
+		element->second.setOverrideFlag(overrideFlag);
 
 		if(input[pos] == '}')
 		{
@@ -425,11 +494,7 @@ bool JsonParser::extractArray(JsonNode & node)
 
 	while(true)
 	{
-		//NOTE: currently 50% of time is this vector resizing.
-		//May be useful to use list during parsing and then swap() all items to vector
-		node.Vector().resize(node.Vector().size() + 1);
-
-		if(!extractElement(node.Vector().back(), ']'))
+		if(!extractElement(node.Vector().emplace_back(), ']'))
 			return false;
 
 		if(input[pos] == ']')
@@ -481,52 +546,58 @@ bool JsonParser::extractFloat(JsonNode & node)
 	si64 integerPart = 0;
 	bool isFloat = false;
 
-	if(input[pos] == '+')
+	// number may be last element of truncated input, which is not null-terminated
+	auto current = [this]()
+	{
+		return pos < input.size() ? input[pos] : '\0';
+	};
+
+	if(current() == '+')
 	{
 		if(settings.mode < JsonParsingSettings::JsonFormatMode::JSON5)
 			error("Positive numbers should not have plus sign!", true);
 		pos++;
 	}
-	else if(input[pos] == '-')
+	else if(current() == '-')
 	{
 		pos++;
 		negative = true;
 	}
 
-	if(input[pos] < '0' || input[pos] > '9')
+	if(current() < '0' || current() > '9')
 	{
-		if(input[pos] != '.' && settings.mode < JsonParsingSettings::JsonFormatMode::JSON5)
+		if(current() != '.' && settings.mode < JsonParsingSettings::JsonFormatMode::JSON5)
 			return error("Number expected!");
 	}
 
 	//Extract integer part
-	while(input[pos] >= '0' && input[pos] <= '9')
+	while(current() >= '0' && current() <= '9')
 	{
-		integerPart = integerPart * 10 + (input[pos] - '0');
+		integerPart = integerPart * 10 + (current() - '0');
 		pos++;
 	}
 
 	result = static_cast<double>(integerPart);
 
-	if(input[pos] == '.')
+	if(current() == '.')
 	{
 		//extract fractional part
 		isFloat = true;
 		pos++;
 		double fractMult = 0.1;
 
-		if(settings.mode < JsonParsingSettings::JsonFormatMode::JSON5 && (input[pos] < '0' || input[pos] > '9'))
+		if(settings.mode < JsonParsingSettings::JsonFormatMode::JSON5 && (current() < '0' || current() > '9'))
 			return error("Decimal part expected!");
 
-		while(input[pos] >= '0' && input[pos] <= '9')
+		while(current() >= '0' && current() <= '9')
 		{
-			result = result + fractMult * (input[pos] - '0');
+			result = result + fractMult * (current() - '0');
 			fractMult /= 10;
 			pos++;
 		}
 	}
 
-	if(input[pos] == 'e')
+	if(current() == 'e')
 	{
 		//extract exponential part
 		pos++;
@@ -534,22 +605,22 @@ bool JsonParser::extractFloat(JsonNode & node)
 		bool powerNegative = false;
 		double power = 0;
 
-		if(input[pos] == '-')
+		if(current() == '-')
 		{
 			pos++;
 			powerNegative = true;
 		}
-		else if(input[pos] == '+')
+		else if(current() == '+')
 		{
 			pos++;
 		}
 
-		if(input[pos] < '0' || input[pos] > '9')
+		if(current() < '0' || current() > '9')
 			return error("Exponential part expected!");
 
-		while(input[pos] >= '0' && input[pos] <= '9')
+		while(current() >= '0' && current() <= '9')
 		{
-			power = power * 10 + (input[pos] - '0');
+			power = power * 10 + (current() - '0');
 			pos++;
 		}
 
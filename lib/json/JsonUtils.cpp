@@ -119,7 +119,10 @@ bool JsonUtils::validate(const JsonNode & node, const std::string & schemaName,
 const JsonNode & getSchemaByName(const std::string & name)
 {
 	// cached schemas to avoid loading json data multiple times
+	// may be accessed from multiple threads during parallel mod loading
 	static std::map<std::string, JsonNode> loadedSchemas;
+	static std::mutex loadedSchemasMutex;
+	std::lock_guard lock(loadedSchemasMutex);
 
 	if (vstd::contains(loadedSchemas, name))
 		return loadedSchemas[name];
@@ -19,6 +19,8 @@
 #include "../modding/CModHandler.h"
 #include "../ScopeGuard.h"
 
+#include <shared_mutex>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 // Algorithm for detection of typos in words
@@ -116,26 +118,40 @@ static std::string schemaListCheck(JsonValidator & validator,
 							const std::string & errorMsg,
 							const std::function<bool(size_t)> & isValid)
 {
-	std::string errors = "<tested schemas>\n";
 	size_t result = 0;
 
-	for(const auto & schemaEntry : schema.Vector())
 	{
-		std::string error = validator.check(schemaEntry, data);
-		if (error.empty())
+		// only number of passed schemas is needed, error messages are generated only if this check fails
+		validator.silentChecks++;
+		auto onExit = vstd::makeScopeGuard([&validator]()
 		{
-			result++;
+			validator.silentChecks--;
+		});
+
+		for(const auto & schemaEntry : schema.Vector())
+		{
+			if (validator.check(schemaEntry, data).empty())
+				result++;
 		}
-		else
+	}
+
+	if (isValid(result))
+		return "";
+
+	if (validator.silentChecks != 0)
+		return validator.makeErrorMessage(errorMsg);
+
+	std::string errors = "<tested schemas>\n";
+	for(const auto & schemaEntry : schema.Vector())
+	{
+		std::string error = validator.check(schemaEntry, data);
+		if (!error.empty())
 		{
 			errors += error;
 			errors += "<end of schema>\n";
 		}
 	}
-	if (isValid(result))
-		return "";
-	else
-		return validator.makeErrorMessage(errorMsg) + errors;
+	return validator.makeErrorMessage(errorMsg) + errors;
 }
 
 static std::string allOfCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
@@ -164,7 +180,11 @@ static std::string oneOfCheck(JsonValidator & validator, const JsonNode & baseSc
 
 static std::string notCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
 {
-	if (validator.check(schema, data).empty())
+	validator.silentChecks++;
+	bool passed = validator.check(schema, data).empty();
+	validator.silentChecks--;
+
+	if (passed)
 		return validator.makeErrorMessage("Successful validation against negative check");
 	return "";
 }
@@ -223,21 +243,13 @@ static std::string typeCheck(JsonValidator & validator, const JsonNode & baseSch
 
 static std::string refCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
 {
-	std::string URI = schema.String();
 	//node must be validated using schema pointed by this reference and not by data here
-	//Local reference. Turn it into more easy to handle remote ref
-	if (boost::algorithm::starts_with(URI, "#"))
-	{
-		const std::string name = validator.usedSchemas.back();
-		const std::string nameClean = name.substr(0, name.find('#'));
-		URI = nameClean + URI;
-	}
-	return validator.check(URI, data);
+	return validator.checkReference(schema, data);
 }
 
 static std::string formatCheck(JsonValidator & validator, const JsonNode & baseSchema, const JsonNode & schema, const JsonNode & data)
 {
-	auto formats = validator.getKnownFormats();
+	const auto & formats = validator.getKnownFormats();
 	std::string errors;
 	auto checker = formats.find(schema.String());
 	if (checker != formats.end())
@@ -310,8 +322,7 @@ static std::string multipleOfCheck(JsonValidator & validator, const JsonNode & b
 
 static std::string itemEntryCheck(JsonValidator & validator, const JsonVector & items, const JsonNode & schema, size_t index)
 {
-	validator.currentPath.emplace_back();
-	validator.currentPath.back().Float() = static_cast<double>(index);
+	validator.currentPath.emplace_back(index);
 	auto onExit = vstd::makeScopeGuard([&validator]()
 	{
 		validator.currentPath.pop_back();
@@ -437,8 +448,7 @@ static std::string dependenciesCheck(JsonValidator & validator, const JsonNode &
 		{
 			if (deps.second.getType() == JsonNode::JsonType::DATA_VECTOR)
 			{
-				JsonVector depList = deps.second.Vector();
-				for(auto & depEntry : depList)
+				for(const auto & depEntry : deps.second.Vector())
 				{
 					if (data[depEntry.String()].isNull())
 						errors += validator.makeErrorMessage("Property " + depEntry.String() + " required for " + deps.first + " is missing");
@@ -446,7 +456,11 @@ static std::string dependenciesCheck(JsonValidator & validator, const JsonNode &
 			}
 			else
 			{
-				if (!validator.check(deps.second, data).empty())
+				validator.silentChecks++;
+				bool passed = validator.check(deps.second, data).empty();
+				validator.silentChecks--;
+
+				if (!passed)
 					errors += validator.makeErrorMessage("Requirements for " + deps.first + " are not fulfilled");
 			}
 		}
@@ -456,8 +470,7 @@ static std::string dependenciesCheck(JsonValidator & validator, const JsonNode &
 
 static std::string propertyEntryCheck(JsonValidator & validator, const JsonNode &node, const JsonNode & schema, const std::string & nodeName)
 {
-	validator.currentPath.emplace_back();
-	validator.currentPath.back().String() = nodeName;
+	validator.currentPath.emplace_back(std::string_view(nodeName));
 	auto onExit = vstd::makeScopeGuard([&validator]()
 	{
 		validator.currentPath.pop_back();
@@ -679,19 +692,82 @@ JsonValidator::TFormatMap createFormatMap()
 	return ret;
 }
 
+/// Schema node prepared for validation of specific type of data: its keywords matched to their checks
+using TCompiledKeywords = std::vector<std::pair<const JsonValidator::TFieldValidator *, const JsonNode *>>;
+
+/// Data types that have different sets of keywords: common (null and bool), number, string, array and object
+static constexpr std::array<JsonNode::JsonType, 5> typeGroups = {
+	JsonNode::JsonType::DATA_NULL,
+	JsonNode::JsonType::DATA_FLOAT,
+	JsonNode::JsonType::DATA_STRING,
+	JsonNode::JsonType::DATA_VECTOR,
+	JsonNode::JsonType::DATA_STRUCT
+};
+
+static size_t getTypeGroup(JsonNode::JsonType type)
+{
+	switch (type)
+	{
+		case JsonNode::JsonType::DATA_FLOAT:
+		case JsonNode::JsonType::DATA_INTEGER:
+			return 1;
+		case JsonNode::JsonType::DATA_STRING: return 2;
+		case JsonNode::JsonType::DATA_VECTOR: return 3;
+		case JsonNode::JsonType::DATA_STRUCT: return 4;
+		default: return 0;
+	}
+}
+
+struct CompiledSchema
+{
+	std::array<TCompiledKeywords, typeGroups.size()> keywords;
+};
+
+struct ResolvedReference
+{
+	std::string URI;
+	const JsonNode * schema;
+};
+
+// Compiled data is identified by address of schema node
+// This is safe since schemas are loaded only once and are never modified or unloaded
+static std::shared_mutex compiledSchemasMutex;
+static std::unordered_map<const JsonNode *, std::unique_ptr<CompiledSchema>> compiledSchemas;
+static std::unordered_map<const JsonNode *, std::unique_ptr<ResolvedReference>> resolvedReferences;
+
+template<typename Value, typename Factory>
+static const Value & getCompiled(std::unordered_map<const JsonNode *, std::unique_ptr<Value>> & cache, const JsonNode & key, const Factory & factory)
+{
+	{
+		std::shared_lock lock(compiledSchemasMutex);
+		auto it = cache.find(&key);
+		if (it != cache.end())
+			return *it->second;
+	}
+
+	// if some other thread compiled same node in meantime, its result will be used
+	auto value = factory();
+	std::unique_lock lock(compiledSchemasMutex);
+	return *cache.try_emplace(&key, std::move(value)).first->second;
+}
+
 std::string JsonValidator::makeErrorMessage(const std::string &message)
 {
+	// result will only be tested for success, skip building of message
+	if (silentChecks != 0)
+		return "failed";
+
 	std::string errors;
 	errors += "At ";
 	if (!currentPath.empty())
 	{
-		for(const JsonNode &path : currentPath)
+		for(const auto & path : currentPath)
 		{
 			errors += "/";
-			if (path.getType() == JsonNode::JsonType::DATA_STRING)
-				errors += path.String();
+			if (std::holds_alternative<std::string_view>(path))
+				errors += std::get<std::string_view>(path);
 			else
-				errors += std::to_string(static_cast<unsigned>(path.Float()));
+				errors += std::to_string(std::get<size_t>(path));
 		}
 	}
 	else
@@ -710,16 +786,58 @@ std::string JsonValidator::check(const std::string & schemaName, const JsonNode
 	return check(JsonUtils::getSchema(schemaName), data);
 }
 
+std::string JsonValidator::checkReference(const JsonNode & reference, const JsonNode & data)
+{
+	const auto & resolved = getCompiled(resolvedReferences, reference, [&]()
+	{
+		std::string URI = reference.String();
+		//Local reference. Turn it into more easy to handle remote ref
+		if (boost::algorithm::starts_with(URI, "#"))
+		{
+			std::string_view name = usedSchemas.back();
+			URI = std::string(name.substr(0, name.find('#'))) + URI;
+		}
+		return std::make_unique<ResolvedReference>(ResolvedReference{URI, &JsonUtils::getSchema(URI)});
+	});
+
+	usedSchemas.push_back(resolved.URI);
+	auto onscopeExit = vstd::makeScopeGuard([this]()
+	{
+		usedSchemas.pop_back();
+	});
+	return check(*resolved.schema, data);
+}
+
 std::string JsonValidator::check(const JsonNode & schema, const JsonNode & data)
 {
-	const TValidatorMap & knownFields = getKnownFieldsFor(data.getType());
-	std::string errors;
-	for(const auto & entry : schema.Struct())
+	const auto & compiled = getCompiled(compiledSchemas, schema, [&]()
 	{
-		auto checker = knownFields.find(entry.first);
-		if (checker != knownFields.end())
-			errors += checker->second(*this, schema, entry.second, data);
-	}
+		using TCheckFunction = std::string(*)(JsonValidator &, const JsonNode &, const JsonNode &, const JsonNode &);
+
+		auto result = std::make_unique<CompiledSchema>();
+		for(size_t group = 0; group < typeGroups.size(); ++group)
+		{
+			const TValidatorMap & knownFields = getKnownFieldsFor(typeGroups[group]);
+			for(const auto & entry : schema.Struct())
+			{
+				auto checker = knownFields.find(entry.first);
+				if (checker == knownFields.end())
+					continue;
+
+				// keywords like "description" are never checked
+				const auto * function = checker->second.target<TCheckFunction>();
+				if (function && *function == emptyCheck)
+					continue;
+
+				result->keywords[group].emplace_back(&checker->second, &entry.second);
+			}
+		}
+		return result;
+	});
+
+	std::string errors;
+	for(const auto & [checker, value] : compiled.keywords[getTypeGroup(data.getType())])
+		errors += (*checker)(*this, schema, *value, data);
 	return errors;
 }
 
@@ -14,15 +14,19 @@
 VCMI_LIB_NAMESPACE_BEGIN
 
 /// Class for Json validation. Mostly compliant with json-schema v6 draf
+/// Schemas are compiled on first use: keywords of each schema node are matched to their checks and references are resolved only once
 struct JsonValidator
 {
 	/// path from root node to current one.
-	/// JsonNode is used as variant - either string (name of node) or as float (index in list)
-	std::vector<JsonNode> currentPath;
+	/// either name of node in struct or index in list. Points to data that is being validated
+	std::vector<std::variant<std::string_view, size_t>> currentPath;
 
 	/// Stack of used schemas. Last schema is the one used currently.
 	/// May contain multiple items in case if remote references were found
-	std::vector<std::string> usedSchemas;
+	std::vector<std::string_view> usedSchemas;
+
+	/// if non-zero, result of checks is only tested for success and error messages are not generated
+	int silentChecks = 0;
 
 	/// generates error message
 	std::string makeErrorMessage(const std::string &message);
@@ -38,6 +42,9 @@ struct JsonValidator
 
 	std::string check(const std::string & schemaName, const JsonNode & data);
 	std::string check(const JsonNode & schema, const JsonNode & data);
+
+	/// validates data against schema referenced by $ref entry of schema
+	std::string checkReference(const JsonNode & reference, const JsonNode & data);
 };
 
 VCMI_LIB_NAMESPACE_END
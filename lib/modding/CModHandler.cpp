@@ -20,7 +20,9 @@
 #include "../CStopWatch.h"
 #include "../GameSettings.h"
 #include "../ScriptHandler.h"
+#include "../VCMIDirs.h"
 #include "../constants/StringConstants.h"
+#include "../filesystem/FileChecksumCache.h"
 #include "../filesystem/Filesystem.h"
 #include "../json/JsonUtils.h"
 #include "../spells/CSpellHandler.h"
@@ -28,6 +30,8 @@
 #include "../texts/Languages.h"
 #include "../VCMI_Lib.h"
 
+#include <tbb/parallel_for.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 static JsonNode loadModSettings(const JsonPath & path)
@@ -294,7 +298,27 @@ static ISimpleResourceLoader * genModFilesystem(const std::string & modName, con
 		return CResourceHandler::createFileSystem(CModInfo::getModDir(modName), defaultFS);
 }
 
-static ui32 calculateModChecksum(const std::string & modName, ISimpleResourceLoader * filesystem)
+static ui32 getResourceChecksum(const ISimpleResourceLoader * filesystem, const ResourcePath & resource, FileChecksumCache & stamps)
+{
+	// archives store checksums of their files, no need to decompress them
+	auto storedChecksum = filesystem->getResourceChecksum(resource);
+	if (storedChecksum)
+		return *storedChecksum;
+
+	auto calculateChecksum = [&]()
+	{
+		return filesystem->load(resource)->calculateCRC32();
+	};
+
+	// plain files are read only if they were modified since previous start
+	auto fileName = filesystem->getResourceName(resource);
+	if (fileName)
+		return stamps.getChecksum(*fileName, calculateChecksum);
+
+	return calculateChecksum();
+}
+
+static ui32 calculateModChecksum(const std::string & modName, ISimpleResourceLoader * filesystem, FileChecksumCache & stamps)
 {
 	boost::crc_32_type modChecksum;
 	// first - add current VCMI version into checksum to force re-validation on VCMI updates
@@ -305,7 +329,7 @@ static ui32 calculateModChecksum(const std::string & modName, ISimpleResourceLoa
 	if (modName != ModScope::scopeBuiltin())
 	{
 		auto modConfFile = CModInfo::getModFile(modName);
-		ui32 configChecksum = CResourceHandler::get("initial")->load(modConfFile)->calculateCRC32();
+		ui32 configChecksum = getResourceChecksum(CResourceHandler::get("initial"), modConfFile, stamps);
 		modChecksum.process_bytes(reinterpret_cast<const void *>(&configChecksum), sizeof(configChecksum));
 	}
 	// third - add all detected text files from this mod into checksum
@@ -317,25 +341,57 @@ static ui32 calculateModChecksum(const std::string & modName, ISimpleResourceLoa
 
 	for (const ResourcePath & file : files)
 	{
-		ui32 fileChecksum = filesystem->load(file)->calculateCRC32();
+		ui32 fileChecksum = getResourceChecksum(filesystem, file, stamps);
 		modChecksum.process_bytes(reinterpret_cast<const void *>(&fileChecksum), sizeof(fileChecksum));
 	}
 	return modChecksum.checksum();
 }
 
+static ui32 calculateContentChecksum(const std::vector<CModInfo *> & mods)
+{
+	// checksum of each mod covers its mod.json and all its data files, so only list of mods and their order is needed on top of it
+	boost::crc_32_type contentChecksum;
+	for(const auto * mod : mods)
+	{
+		ui32 modChecksum = mod->getVerificationInfo().checksum;
+		contentChecksum.process_bytes(reinterpret_cast<const void *>(mod->identifier.data()), mod->identifier.size());
+		contentChecksum.process_bytes(reinterpret_cast<const void *>(&modChecksum), sizeof(modChecksum));
+	}
+	return contentChecksum.checksum();
+}
+
 void CModHandler::loadModFilesystems()
 {
 	CGeneralTextHandler::detectInstallParameters();
 
 	activeMods = validateAndSortDependencies(activeMods);
 
-	coreMod->updateChecksum(calculateModChecksum(ModScope::scopeBuiltin(), CResourceHandler::get(ModScope::scopeBuiltin())));
-
 	for(std::string & modName : activeMods)
 	{
 		CModInfo & mod = allMods[modName];
 		CResourceHandler::addFilesystem("data", modName, genModFilesystem(modName, mod.config));
 	}
+
+	CStopWatch timer;
+	FileChecksumCache stamps(VCMIDirs::get().userCachePath() / "modChecksums.json");
+
+	coreMod->updateChecksum(calculateModChecksum(ModScope::scopeBuiltin(), CResourceHandler::get(ModScope::scopeBuiltin()), stamps));
+
+	std::vector<ui32> checksums(activeMods.size());
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, activeMods.size()), [&](const tbb::blocked_range<size_t> & range)
+	{
+		for(size_t i = range.begin(); i != range.end(); ++i)
+		{
+			logMod->trace("Generating checksum for %s", activeMods[i]);
+			checksums[i] = calculateModChecksum(activeMods[i], CResourceHandler::get(activeMods[i]), stamps);
+		}
+	});
+
+	for(size_t i = 0; i < activeMods.size(); ++i)
+		allMods.at(activeMods[i]).updateChecksum(checksums[i]);
+
+	stamps.save();
+	logMod->info("\tCalculating mod checksums: %d ms", timer.getDiff());
 }
 
 TModID CModHandler::findResourceOrigin(const ResourcePath & name) const
@@ -445,6 +501,11 @@ void CModHandler::loadTranslation(const TModID & modName)
 	VLC->generaltexth->loadTranslationOverrides(preferredLanguage, modName, extraTranslation);
 }
 
+boost::filesystem::path CModHandler::getContentCachePath()
+{
+	return VCMIDirs::get().userCachePath() / "modDataCache.bin";
+}
+
 void CModHandler::load()
 {
 	CStopWatch totalTime;
@@ -454,18 +515,33 @@ void CModHandler::load()
 
 	content->init();
 
+	// first - load virtual builtin mod that contains all data
+	// TODO? move all data into real mods? RoE, AB, SoD, WoG
+	std::vector<CModInfo *> modsToLoad = { coreMod.get() };
 	for(const TModID & modName : activeMods)
+		modsToLoad.push_back(&allMods.at(modName));
+
+	ui32 contentChecksum = calculateContentChecksum(modsToLoad);
+
+	if (content->loadCache(getContentCachePath(), contentChecksum))
 	{
-		logMod->trace("Generating checksum for %s", modName);
-		allMods[modName].updateChecksum(calculateModChecksum(modName, CResourceHandler::get(modName)));
+		for(const auto * mod : modsToLoad)
+			logMod->info("\t\t[%08x]%s (cached)", mod->getVerificationInfo().checksum, mod->getVerificationInfo().name);
+		logMod->info("\tRestoring mod data from cache: %d ms", timer.getDiff());
 	}
+	else
+	{
+		content->preloadData(modsToLoad);
+		logMod->info("\tParsing mod data: %d ms", timer.getDiff());
 
-	// first - load virtual builtin mod that contains all data
-	// TODO? move all data into real mods? RoE, AB, SoD, WoG
-	content->preloadData(*coreMod);
-	for(const TModID & modName : activeMods)
-		content->preloadData(allMods[modName]);
-	logMod->info("\tParsing mod data: %d ms", timer.getDiff());
+		// do not cache data of mods that failed validation so these mods will be reported again on next start
+		bool allModsValid = std::none_of(modsToLoad.begin(), modsToLoad.end(), [](const CModInfo * mod){ return mod->validation == CModInfo::FAILED; });
+		if (allModsValid)
+		{
+			content->saveCache(getContentCachePath(), contentChecksum);
+			logMod->info("\tSaving mod data cache: %d ms", timer.getDiff());
+		}
+	}
 
 	content->load(*coreMod);
 	for(const TModID & modName : activeMods)
@@ -77,6 +77,9 @@ public:
 	
 	const CModInfo & getModInfo(const TModID & modId) const;
 
+	/// file in which preloaded data of all active mods is cached between game starts
+	static boost::filesystem::path getContentCachePath();
+
 	/// load content from all available mods
 	void load();
 	void afterLoad(bool onlyEssential);
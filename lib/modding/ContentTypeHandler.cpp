@@ -34,9 +34,13 @@
 #include "../json/JsonUtils.h"
 #include "../mapObjectConstructors/CObjectClassesHandler.h"
 #include "../rmg/CRmgTemplateStorage.h"
+#include "../serializer/CLoadFile.h"
+#include "../serializer/CSaveFile.h"
 #include "../spells/CSpellHandler.h"
 #include "../VCMI_Lib.h"
 
+#include <tbb/parallel_for.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 ContentTypeHandler::ContentTypeHandler(IHandlerBase * handler, const std::string & objectName):
@@ -50,10 +54,13 @@ ContentTypeHandler::ContentTypeHandler(IHandlerBase * handler, const std::string
 	}
 }
 
-bool ContentTypeHandler::preloadModData(const std::string & modName, const std::vector<std::string> & fileList, bool validate)
+JsonNode ContentTypeHandler::parseModData(const std::vector<std::string> & fileList, bool & isValid) const
+{
+	return JsonUtils::assembleFromFiles(fileList, isValid);
+}
+
+void ContentTypeHandler::preloadModData(const std::string & modName, JsonNode data)
 {
-	bool result = false;
-	JsonNode data = JsonUtils::assembleFromFiles(fileList, result);
 	data.setModScope(modName);
 
 	ModInfo & modInfo = modData[modName];
@@ -82,20 +89,21 @@ bool ContentTypeHandler::preloadModData(const std::string & modName, const std::
 			JsonUtils::merge(remoteConf, entry.second);
 		}
 	}
-	return result;
 }
 
 bool ContentTypeHandler::loadMod(const std::string & modName, bool validate)
 {
-	ModInfo & modInfo = modData[modName];
-	bool result = true;
-
-	auto performValidate = [&,this](JsonNode & data, const std::string & name){
-		handler->beforeValidate(data);
-		if (validate)
-			result &= JsonUtils::validate(data, "vcmi:" + objectName, name);
+	struct PendingObject
+	{
+		const std::string * name;
+		JsonNode * data;
+		size_t index;
+		bool hasIndex;
 	};
 
+	ModInfo & modInfo = modData[modName];
+	std::vector<PendingObject> objects;
+
 	// apply patches
 	if (!modInfo.patches.isNull())
 		JsonUtils::merge(modInfo.modData, modInfo.patches);
@@ -138,18 +146,38 @@ bool ContentTypeHandler::loadMod(const std::string & modName, bool validate)
 			{
 				logMod->trace("no original data in loadMod(%s) at index %d", name, index);
 			}
-			performValidate(data, name);
-			handler->loadObject(modName, name, data, index);
+			objects.push_back({&name, &data, index, true});
 		}
 		else
 		{
 			// normal new object
 			logMod->trace("no index in loadMod(%s)", name);
-			performValidate(data,name);
-			handler->loadObject(modName, name, data);
+			objects.push_back({&name, &data, 0, false});
 		}
 	}
-	return result;
+
+	// validation only reads schemas and modifies object own data, so objects can be validated in parallel
+	// loading itself modifies handler and must be done sequentially, in same order as objects are listed in mod
+	std::vector<uint8_t> validationResults(objects.size(), true);
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, objects.size()), [&](const tbb::blocked_range<size_t> & range)
+	{
+		for(size_t i = range.begin(); i != range.end(); ++i)
+		{
+			handler->beforeValidate(*objects[i].data);
+			if (validate)
+				validationResults[i] = JsonUtils::validate(*objects[i].data, "vcmi:" + objectName, *objects[i].name);
+		}
+	});
+
+	for(const auto & object : objects)
+	{
+		if (object.hasIndex && modName == "core")
+			handler->loadObject(modName, *object.name, *object.data, object.index);
+		else
+			handler->loadObject(modName, *object.name, *object.data);
+	}
+
+	return vstd::contains(validationResults, false) == false;
 }
 
 void ContentTypeHandler::loadCustom()
@@ -211,16 +239,6 @@ void CContentHandler::init()
 	handlers.insert(std::make_pair("biomes", ContentTypeHandler(VLC->biomeHandler.get(), "biome")));
 }
 
-bool CContentHandler::preloadModData(const std::string & modName, JsonNode modConfig, bool validate)
-{
-	bool result = true;
-	for(auto & handler : handlers)
-	{
-		result &= handler.second.preloadModData(modName, modConfig[handler.first].convertTo<std::vector<std::string> >(), validate);
-	}
-	return result;
-}
-
 bool CContentHandler::loadMod(const std::string & modName, bool validate)
 {
 	bool result = true;
@@ -247,21 +265,142 @@ void CContentHandler::afterLoadFinalization()
 	}
 }
 
-void CContentHandler::preloadData(CModInfo & mod)
+void CContentHandler::preloadData(const std::vector<CModInfo *> & mods)
 {
-	bool validate = (mod.validation != CModInfo::PASSED);
+	std::vector<std::pair<const std::string, ContentTypeHandler> *> handlersList;
+	for(auto & handler : handlers)
+		handlersList.push_back(&handler);
+
+	// parsing of json files takes most of the time and does not depends on other mods - process all files in parallel
+	const size_t tasksPerMod = handlersList.size();
+	std::vector<JsonNode> parsedData(mods.size() * tasksPerMod);
+	std::vector<uint8_t> parsedValid(mods.size() * tasksPerMod, true);
+
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, parsedData.size()), [&](const tbb::blocked_range<size_t> & range)
+	{
+		for(size_t i = range.begin(); i != range.end(); ++i)
+		{
+			const CModInfo & mod = *mods[i / tasksPerMod];
+			const auto & [name, handler] = *handlersList[i % tasksPerMod];
+
+			bool isValid = true;
+			parsedData[i] = handler.parseModData(mod.config[name].convertTo<std::vector<std::string>>(), isValid);
+			parsedValid[i] = isValid;
+		}
+	});
+
+	// merging must be done in load order since mods may patch objects from mods loaded before them
+	for(size_t modIndex = 0; modIndex < mods.size(); ++modIndex)
+	{
+		CModInfo & mod = *mods[modIndex];
+		bool validate = (mod.validation != CModInfo::PASSED);
+
+		// print message in format [<8-symbols checksum>] <modname>
+		auto & info = mod.getVerificationInfo();
+		logMod->info("\t\t[%08x]%s", info.checksum, info.name);
+
+		if (validate && mod.identifier != ModScope::scopeBuiltin())
+		{
+			if (!JsonUtils::validate(mod.config, "vcmi:mod", mod.identifier))
+				mod.validation = CModInfo::FAILED;
+		}
 
-	// print message in format [<8-symbols checksum>] <modname>
-	auto & info = mod.getVerificationInfo();
-	logMod->info("\t\t[%08x]%s", info.checksum, info.name);
+		for(size_t handlerIndex = 0; handlerIndex < tasksPerMod; ++handlerIndex)
+		{
+			size_t taskIndex = modIndex * tasksPerMod + handlerIndex;
+
+			if (!parsedValid[taskIndex])
+				mod.validation = CModInfo::FAILED;
+
+			handlersList[handlerIndex]->second.preloadModData(mod.identifier, std::move(parsedData[taskIndex]));
+		}
+	}
+}
+
+static const std::string CONTENT_CACHE_MAGIC = "VCMIMODS";
+
+void CContentHandler::saveCache(const boost::filesystem::path & file, ui32 checksum) const
+{
+	// write into temporary file first, so interrupted write or another game instance can't leave truncated cache behind
+	boost::filesystem::path temporaryPath = file;
+	temporaryPath += ".tmp";
+
+	boost::system::error_code ec;
+
+	try
+	{
+		CSaveFile cache(temporaryPath);
+		cache.putMagicBytes(CONTENT_CACHE_MAGIC);
+		cache << checksum;
 
-	if (validate && mod.identifier != ModScope::scopeBuiltin())
+		for(const auto & handler : handlers)
+		{
+			cache << handler.first;
+			cache << handler.second.modData;
+		}
+	}
+	catch(const std::exception & e)
 	{
-		if (!JsonUtils::validate(mod.config, "vcmi:mod", mod.identifier))
-			mod.validation = CModInfo::FAILED;
+		logMod->warn("Failed to save mod data cache to %s: %s", file.string(), e.what());
+		boost::filesystem::remove(temporaryPath, ec);
+		return;
 	}
-	if (!preloadModData(mod.identifier, mod.config, validate))
-		mod.validation = CModInfo::FAILED;
+
+	boost::filesystem::rename(temporaryPath, file, ec);
+	if(ec)
+	{
+		logMod->warn("Failed to store mod data cache to %s: %s", file.string(), ec.message());
+		boost::filesystem::remove(temporaryPath, ec);
+	}
+}
+
+bool CContentHandler::loadCache(const boost::filesystem::path & file, ui32 checksum)
+{
+	if (!boost::filesystem::exists(file))
+		return false;
+
+	std::map<std::string, std::map<std::string, ContentTypeHandler::ModInfo>> loadedData;
+
+	try
+	{
+		CLoadFile cache(file);
+		cache.checkMagicBytes(CONTENT_CACHE_MAGIC);
+
+		ui32 cachedChecksum = 0;
+		cache >> cachedChecksum;
+
+		if (cachedChecksum != checksum)
+		{
+			logMod->debug("Mod data cache is outdated, expected checksum %08x, found %08x", checksum, cachedChecksum);
+			return false;
+		}
+
+		for(size_t i = 0; i < handlers.size(); ++i)
+		{
+			std::string name;
+			cache >> name;
+			cache >> loadedData[name];
+		}
+	}
+	catch(const std::exception & e)
+	{
+		logMod->warn("Failed to load mod data cache from %s: %s", file.string(), e.what());
+		return false;
+	}
+
+	for(const auto & handler : handlers)
+	{
+		if (!loadedData.count(handler.first))
+		{
+			logMod->warn("Mod data cache from %s has no data for %s", file.string(), handler.first);
+			return false;
+		}
+	}
+
+	for(auto & handler : handlers)
+		handler.second.modData = std::move(loadedData.at(handler.first));
+
+	return true;
 }
 
 void CContentHandler::load(CModInfo & mod)
@@ -26,6 +26,12 @@ public:
 		JsonNode modData;
 		/// mod data for this mod from other mods (patches)
 		JsonNode patches;
+
+		template <typename Handler> void serialize(Handler & h)
+		{
+			h & modData;
+			h & patches;
+		}
 	};
 	/// handler to which all data will be loaded
 	IHandlerBase * handler;
@@ -37,9 +43,12 @@ public:
 
 	ContentTypeHandler(IHandlerBase * handler, const std::string & objectName);
 
+	/// parses and merges all files from fileList. Does not modify handler and can be called from multiple threads
+	JsonNode parseModData(const std::vector<std::string> & fileList, bool & isValid) const;
+
 	/// local version of methods in ContentHandler
 	/// returns true if loading was successful
-	bool preloadModData(const std::string & modName, const std::vector<std::string> & fileList, bool validate);
+	void preloadModData(const std::string & modName, JsonNode data);
 	bool loadMod(const std::string & modName, bool validate);
 	void loadCustom();
 	void afterLoadFinalization();
@@ -48,9 +57,6 @@ public:
 /// class used to load all game data into handlers. Used only during loading
 class DLL_LINKAGE CContentHandler
 {
-	/// preloads all data from fileList as data from modName.
-	bool preloadModData(const std::string & modName, JsonNode modConfig, bool validate);
-
 	/// actually loads data in mod
 	bool loadMod(const std::string & modName, bool validate);
 
@@ -59,8 +65,15 @@ class DLL_LINKAGE CContentHandler
 public:
 	void init();
 
-	/// preloads all data from fileList as data from modName.
-	void preloadData(CModInfo & mod);
+	/// preloads data of all mods. Files are parsed in parallel, results are merged in order of mods list
+	void preloadData(const std::vector<CModInfo *> & mods);
+
+	/// saves preloaded data of all mods into binary file, with checksum of all loaded mods as key
+	void saveCache(const boost::filesystem::path & file, ui32 checksum) const;
+
+	/// restores preloaded data from binary file instead of preloadData
+	/// returns false if file is missing, damaged, or was created for different set of mods
+	bool loadCache(const boost::filesystem::path & file, ui32 checksum);
 
 	/// actually loads data in mod
 	void load(CModInfo & mod);
@@ -115,7 +115,7 @@ void CIdentifierStorage::requestIdentifier(ObjectCallback callback) const
 	assert(!callback.localScope.empty());
 
 	if (state != ELoadingState::FINISHED) // enqueue request if loading is still in progress
-		scheduledRequests.push_back(callback);
+		scheduledRequests.push_back(std::move(callback));
 	else // execute immediately for "late" requests
 		resolveIdentifier(callback);
 }
@@ -258,18 +258,27 @@ void CIdentifierStorage::showIdentifierResolutionErrorDetails(const ObjectCallba
 
 	if (options.dynamicType && options.type.empty())
 	{
-		bool suggestionFound = false;
+		// registered objects are not ordered, sort suggestions so output does not change between runs
+		std::vector<const std::pair<const std::string, std::vector<ObjectData>> *> suggestions;
 
 		for (auto const & entry : registeredObjects)
 		{
-			if (!boost::algorithm::ends_with(entry.first, options.name))
-				continue;
+			if (boost::algorithm::ends_with(entry.first, options.name))
+				suggestions.push_back(&entry);
+		}
+
+		boost::range::sort(suggestions, [](const auto * left, const auto * right)
+		{
+			return left->first < right->first;
+		});
 
-			suggestionFound = true;
-			logMod->error("Perhaps you wanted to use identifier '%s' from mod '%s' instead?", entry.first, entry.second.scope);
+		for (auto const * entry : suggestions)
+		{
+			for (auto const & object : entry->second)
+				logMod->error("Perhaps you wanted to use identifier '%s' from mod '%s' instead?", entry->first, object.scope);
 		}
 
-		if (suggestionFound)
+		if (!suggestions.empty())
 			return;
 	}
 
@@ -336,11 +345,11 @@ void CIdentifierStorage::registerObject(const std::string & scope, const std::st
 	std::string fullID = type + '.' + name;
 	checkIdentifier(fullID);
 
-	std::pair<const std::string, ObjectData> mapping = std::make_pair(fullID, data);
-	if(!vstd::containsMapping(registeredObjects, mapping))
+	auto & entries = registeredObjects[fullID];
+	if(!vstd::contains(entries, data))
 	{
 		logMod->trace("registered '%s' as %s:%s", fullID, scope, identifier);
-		registeredObjects.insert(mapping);
+		entries.push_back(data);
 	}
 	else
 	{
@@ -348,7 +357,7 @@ void CIdentifierStorage::registerObject(const std::string & scope, const std::st
 	}
 }
 
-std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdentifiers(const ObjectCallback & request) const
+std::set<std::string> CIdentifierStorage::getAllowedScopes(const ObjectCallback & request) const
 {
 	std::set<std::string> allowedScopes;
 	bool isValidScope = true;
@@ -369,7 +378,7 @@ std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdent
 			allowedScopes = VLC->modh->getModDependencies(request.localScope, isValidScope);
 
 			if(!isValidScope)
-				return std::vector<ObjectData>();
+				return {};
 
 			allowedScopes.insert(request.localScope);
 		}
@@ -401,30 +410,48 @@ std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdent
 			auto myDeps = VLC->modh->getModDependencies(request.localScope, isValidScope);
 
 			if(!isValidScope)
-				return std::vector<ObjectData>();
+				return {};
 
 			if(myDeps.count(request.remoteScope))
 				allowedScopes.insert(request.remoteScope);
 		}
 	}
 
+	return allowedScopes;
+}
+
+std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdentifiers(const ObjectCallback & request) const
+{
 	std::string fullID = request.type + '.' + request.name;
 
-	auto entries = registeredObjects.equal_range(fullID);
-	if (entries.first != entries.second)
+	auto entries = registeredObjects.find(fullID);
+	if (entries == registeredObjects.end())
+		return std::vector<ObjectData>();
+
+	auto filterByScope = [&](const std::set<std::string> & allowedScopes)
 	{
 		std::vector<ObjectData> locatedIDs;
 
-		for (auto it = entries.first; it != entries.second; it++)
+		for (const auto & object : entries->second)
 		{
-			if (vstd::contains(allowedScopes, it->second.scope))
-			{
-				locatedIDs.push_back(it->second);
-			}
+			if (vstd::contains(allowedScopes, object.scope))
+				locatedIDs.push_back(object);
 		}
 		return locatedIDs;
+	};
+
+	// during finalization large number of requests is resolved at once, mostly from small number of scopes
+	// dependencies of mods can't change at this point, so accessible scopes can be computed once per scope
+	if (state == ELoadingState::FINALIZING)
+	{
+		auto key = std::make_pair(request.localScope, request.remoteScope);
+		auto it = allowedScopesCache.find(key);
+		if (it == allowedScopesCache.end())
+			it = allowedScopesCache.emplace(key, getAllowedScopes(request)).first;
+		return filterByScope(it->second);
 	}
-	return std::vector<ObjectData>();
+
+	return filterByScope(getAllowedScopes(request));
 }
 
 bool CIdentifierStorage::resolveIdentifier(const ObjectCallback & request) const
@@ -452,14 +479,18 @@ void CIdentifierStorage::finalize()
 
 	state = ELoadingState::FINALIZING;
 
+	size_t resolvedRequests = 0;
 	while ( !scheduledRequests.empty() )
 	{
 		// Use local copy since new requests may appear during resolving, invalidating any iterators
-		auto request = scheduledRequests.back();
+		auto request = std::move(scheduledRequests.back());
 		scheduledRequests.pop_back();
 		resolveIdentifier(request);
+		resolvedRequests++;
 	}
 
+	logMod->debug("Resolved %d identifier requests using %d distinct scopes", resolvedRequests, allowedScopesCache.size());
+	allowedScopesCache.clear();
 	state = ELoadingState::FINISHED;
 }
 
@@ -469,15 +500,16 @@ void CIdentifierStorage::debugDumpIdentifiers()
 
 	std::map<std::string, std::vector<std::string>> objectList;
 
-	for(const auto & object : registeredObjects)
+	for(const auto & entry : registeredObjects)
 	{
-		size_t categoryLength = object.first.find('.');
+		size_t categoryLength = entry.first.find('.');
 		assert(categoryLength != std::string::npos);
 
-		std::string objectCategory = object.first.substr(0, categoryLength);
-		std::string objectName = object.first.substr(categoryLength + 1);
+		std::string objectCategory = entry.first.substr(0, categoryLength);
+		std::string objectName = entry.first.substr(categoryLength + 1);
 
-		objectList[objectCategory].push_back("[" + object.second.scope + "] " + objectName);
+		for(const auto & object : entry.second)
+			objectList[objectCategory].push_back("[" + object.scope + "] " + objectName);
 	}
 
 	for(auto & category : objectList)
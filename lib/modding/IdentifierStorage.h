@@ -55,9 +55,14 @@ class DLL_LINKAGE CIdentifierStorage
 		}
 	};
 
-	std::multimap<std::string, ObjectData> registeredObjects;
+	/// all registered objects, indexed by full identifier in form "type.name"
+	std::unordered_map<std::string, std::vector<ObjectData>> registeredObjects;
 	mutable std::vector<ObjectCallback> scheduledRequests;
 
+	/// scopes accessible for pair of local and remote scopes of request
+	/// only used during finalization, when all mods are loaded and requests are resolved in bulk
+	mutable std::map<std::pair<std::string, std::string>, std::set<std::string>> allowedScopesCache;
+
 	ELoadingState state = ELoadingState::LOADING;
 
 	/// Helper method that dumps all registered identifier into log file
@@ -69,6 +74,7 @@ class DLL_LINKAGE CIdentifierStorage
 	void requestIdentifier(ObjectCallback callback) const;
 	bool resolveIdentifier(const ObjectCallback & callback) const;
 	std::vector<ObjectData> getPossibleIdentifiers(const ObjectCallback & callback) const;
+	std::set<std::string> getAllowedScopes(const ObjectCallback & callback) const;
 
 	void showIdentifierResolutionErrorDetails(const ObjectCallback & callback) const;
 	std::optional<si32> getIdentifierImpl(const ObjectCallback & callback, bool silent) const;
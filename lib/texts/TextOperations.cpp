@@ -110,6 +110,19 @@ bool TextOperations::isValidUnicodeString(const char * data, size_t size)
 {
 	for (size_t i=0; i<size; i += getUnicodeCharacterSize(data[i]))
 	{
+		// fast path for blocks of ascii characters, which are always valid
+		while (i + sizeof(uint64_t) <= size)
+		{
+			uint64_t word;
+			std::memcpy(&word, data + i, sizeof(word));
+			if (word & 0x8080808080808080ull)
+				break;
+			i += sizeof(word);
+		}
+
+		if (i == size)
+			break;
+
 		if (!isValidUnicodeCharacter(data + i, size - i))
 			return false;
 	}
@@ -258,7 +258,7 @@ public:
 #endif
 	}
 
-	void sendToAllClients(CPackForClient * pack);
+	virtual void sendToAllClients(CPackForClient * pack);
 	void sendAndApply(CPackForClient * pack) override;
 	void sendAndApply(CGarrisonOperationPack * pack);
 	void sendAndApply(SetResources * pack);
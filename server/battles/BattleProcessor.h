@@ -37,11 +37,16 @@ class BattleProcessor : boost::noncopyable
 	friend class BattleFlowProcessor;
 	friend class BattleResultProcessor;
 
+protected:
 	CGameHandler * gameHandler;
 	std::unique_ptr<BattleActionProcessor> actionsProcessor;
 	std::unique_ptr<BattleFlowProcessor> flowProcessor;
 	std::unique_ptr<BattleResultProcessor> resultProcessor;
 
+	/// Sets result of a battle and starts applying its consequences
+	virtual void setBattleResult(const CBattleInfoCallback & battle, EBattleResult resultType, BattleSide victoriusSide);
+
+private:
 	void updateGateState(const CBattleInfoCallback & battle);
 	void engageIntoBattle(PlayerColor player);
 
@@ -50,11 +55,9 @@ class BattleProcessor : boost::noncopyable
 
 	bool makeAutomaticBattleAction(const CBattleInfoCallback & battle, const BattleAction & ba);
 
-	void setBattleResult(const CBattleInfoCallback & battle, EBattleResult resultType, BattleSide victoriusSide);
-
 public:
 	explicit BattleProcessor(CGameHandler * gameHandler);
-	~BattleProcessor();
+	virtual ~BattleProcessor();
 
 	/// Starts battle with specified parameters
 	void startBattle(const CArmedInstance *army1, const CArmedInstance *army2, int3 tile, const CGHeroInstance *hero1, const CGHeroInstance *hero2, const BattleLayout & layout, const CGTownInstance *town);
@@ -0,0 +1,203 @@
+/*
+ * ImageAtlasTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../client/render/Colors.h"
+#include "../../client/renderSDL/ImageAtlas.h"
+#include "../../client/renderSDL/SDLImage.h"
+
+#include <SDL_surface.h>
+
+class ImageAtlasTest : public testing::Test
+{
+protected:
+	ImageAtlas::Statistics statistics;
+
+	/// creates 32-bit image in which every pixel has different value
+	static std::shared_ptr<ISharedImage> createImage(int width, int height, uint32_t seed)
+	{
+		SDL_Surface * surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+
+		for(int y = 0; y < height; ++y)
+		{
+			auto * row = reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(surface->pixels) + y * surface->pitch);
+			for(int x = 0; x < width; ++x)
+				row[x] = 0xff000000 | (seed * 0x10000 + y * width + x);
+		}
+
+		auto result = std::make_shared<SDLImageShared>(surface);
+		SDL_FreeSurface(surface);
+		return result;
+	}
+
+	/// creates indexed image with its own palette and color key
+	static std::shared_ptr<ISharedImage> createIndexedImage(int width, int height, uint8_t seed)
+	{
+		SDL_Surface * surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 8, SDL_PIXELFORMAT_INDEX8);
+
+		std::array<SDL_Color, 256> colors;
+		for(int i = 0; i < 256; ++i)
+			colors[i] = { static_cast<uint8_t>(i), static_cast<uint8_t>(seed), static_cast<uint8_t>(255 - i), SDL_ALPHA_OPAQUE };
+		SDL_SetPaletteColors(surface->format->palette, colors.data(), 0, colors.size());
+		SDL_SetColorKey(surface, SDL_TRUE, 0);
+
+		for(int y = 0; y < height; ++y)
+		{
+			auto * row = static_cast<uint8_t *>(surface->pixels) + y * surface->pitch;
+			for(int x = 0; x < width; ++x)
+				row[x] = static_cast<uint8_t>(seed + y * width + x);
+		}
+
+		auto result = std::make_shared<SDLImageShared>(surface);
+		SDL_FreeSurface(surface);
+		return result;
+	}
+
+	/// returns pixels of image drawn on empty 32-bit surface
+	static std::vector<uint32_t> render(const ISharedImage & image)
+	{
+		Point size = image.dimensions();
+		SDL_Surface * target = SDL_CreateRGBSurfaceWithFormat(0, size.x, size.y, 32, SDL_PIXELFORMAT_ARGB8888);
+
+		image.draw(target, nullptr, Point(0, 0), nullptr, Colors::WHITE_TRUE, SDL_ALPHA_OPAQUE, EImageBlitMode::COLORKEY);
+
+		std::vector<uint32_t> result;
+		for(int y = 0; y < target->h; ++y)
+		{
+			const auto * row = reinterpret_cast<const uint32_t *>(static_cast<const uint8_t *>(target->pixels) + y * target->pitch);
+			result.insert(result.end(), row, row + target->w);
+		}
+
+		SDL_FreeSurface(target);
+		return result;
+	}
+
+	static void expectSameContent(const std::vector<std::shared_ptr<ISharedImage>> & images, const std::vector<std::shared_ptr<ISharedImage>> & packed)
+	{
+		ASSERT_EQ(images.size(), packed.size());
+
+		for(size_t i = 0; i < images.size(); ++i)
+		{
+			EXPECT_EQ(packed[i]->dimensions(), images[i]->dimensions()) << "image " << i;
+			EXPECT_EQ(render(*packed[i]), render(*images[i])) << "image " << i;
+		}
+	}
+};
+
+TEST_F(ImageAtlasTest, imagesOfSameFormatArePacked)
+{
+	std::vector<std::shared_ptr<ISharedImage>> images = {
+		createImage(32, 32, 1),
+		createImage(17, 5, 2),
+		createImage(64, 3, 3),
+		createImage(1, 40, 4),
+		createImage(33, 33, 5)
+	};
+
+	auto packed = ImageAtlas::pack(images, statistics);
+
+	for(size_t i = 0; i < images.size(); ++i)
+		EXPECT_NE(packed[i], images[i]) << "image " << i;
+
+	expectSameContent(images, packed);
+	EXPECT_EQ(statistics.atlases, 1);
+	EXPECT_EQ(statistics.images, images.size());
+	EXPECT_GE(statistics.atlasBytes, statistics.imageBytes);
+}
+
+TEST_F(ImageAtlasTest, indexedImagesKeepTheirPalettes)
+{
+	std::vector<std::shared_ptr<ISharedImage>> images = {
+		createIndexedImage(20, 10, 10),
+		createIndexedImage(7, 13, 100),
+		createIndexedImage(31, 2, 200)
+	};
+
+	auto packed = ImageAtlas::pack(images, statistics);
+
+	expectSameContent(images, packed);
+	EXPECT_EQ(statistics.atlases, 1);
+	EXPECT_EQ(statistics.images, images.size());
+}
+
+TEST_F(ImageAtlasTest, formatsArePackedSeparately)
+{
+	std::vector<std::shared_ptr<ISharedImage>> images = {
+		createImage(16, 16, 1),
+		createIndexedImage(16, 16, 2),
+		createImage(8, 8, 3),
+		createIndexedImage(8, 8, 4)
+	};
+
+	auto packed = ImageAtlas::pack(images, statistics);
+
+	expectSameContent(images, packed);
+	EXPECT_EQ(statistics.atlases, 2);
+	EXPECT_EQ(statistics.images, images.size());
+}
+
+TEST_F(ImageAtlasTest, singleImageIsNotPacked)
+{
+	std::vector<std::shared_ptr<ISharedImage>> images = {
+		createImage(16, 16, 1),
+		createIndexedImage(16, 16, 2)
+	};
+
+	auto packed = ImageAtlas::pack(images, statistics);
+
+	EXPECT_EQ(packed, images);
+	EXPECT_EQ(statistics.atlases, 0);
+	EXPECT_EQ(statistics.images, 0);
+}
+
+TEST_F(ImageAtlasTest, largeImagesAreNotPacked)
+{
+	std::vector<std::shared_ptr<ISharedImage>> images = {
+		createImage(2049, 1, 1),
+		createImage(16, 16, 2),
+		createImage(8, 8, 3)
+	};
+
+	auto packed = ImageAtlas::pack(images, statistics);
+
+	EXPECT_EQ(packed[0], images[0]);
+	EXPECT_NE(packed[1], images[1]);
+	EXPECT_NE(packed[2], images[2]);
+	expectSameContent(images, packed);
+	EXPECT_EQ(statistics.images, 2);
+}
+
+TEST_F(ImageAtlasTest, packedImagesAreNotPackedAgain)
+{
+	std::vector<std::shared_ptr<ISharedImage>> images = {
+		createImage(16, 16, 1),
+		createImage(8, 8, 2)
+	};
+
+	auto packed = ImageAtlas::pack(images, statistics);
+	auto repacked = ImageAtlas::pack(packed, statistics);
+
+	EXPECT_EQ(repacked, packed);
+	EXPECT_EQ(statistics.atlases, 1);
+}
+
+TEST_F(ImageAtlasTest, manyImagesFitIntoAtlas)
+{
+	std::vector<std::shared_ptr<ISharedImage>> images;
+	for(int i = 0; i < 200; ++i)
+		images.push_back(createImage(1 + i % 50, 1 + (i * 7) % 40, i));
+
+	auto packed = ImageAtlas::pack(images, statistics);
+
+	expectSameContent(images, packed);
+	EXPECT_EQ(statistics.atlases, 1);
+	EXPECT_EQ(statistics.images, images.size());
+}
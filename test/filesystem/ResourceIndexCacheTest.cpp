@@ -0,0 +1,193 @@
+/*
+ * ResourceIndexCacheTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/VCMIDirs.h"
+#include "../../lib/filesystem/CFilesystemLoader.h"
+#include "../../lib/filesystem/ResourceIndexCache.h"
+#include "../../lib/json/JsonNode.h"
+
+namespace fs = boost::filesystem;
+
+class ResourceIndexCacheTest : public testing::Test
+{
+protected:
+	fs::path directory;
+
+	void SetUp() override
+	{
+		directory = fs::temp_directory_path() / fs::unique_path("vcmitest-%%%%-%%%%-%%%%");
+		fs::create_directories(directory);
+	}
+
+	void TearDown() override
+	{
+		boost::system::error_code ec;
+		fs::remove_all(directory, ec);
+	}
+
+	void createFile(const fs::path & path)
+	{
+		fs::create_directories((directory / path).parent_path());
+		std::ofstream file((directory / path).c_str());
+		file << "{}";
+	}
+
+	/// index is only stored for directories that were not modified recently, since timestamps have limited precision
+	void setModificationTime(const fs::path & path, std::time_t age)
+	{
+		fs::last_write_time(directory / path, std::time(nullptr) - age);
+	}
+
+	static bool exists(const CFilesystemLoader & loader, const std::string & name)
+	{
+		return loader.existsResource(ResourcePath(name, EResType::JSON));
+	}
+
+	/// returns key that is unique for this test, so tests do not see indexes stored by each other or by previous runs
+	std::string uniqueKey(const std::string & name) const
+	{
+		return "test|" + directory.string() + "|" + name;
+	}
+};
+
+TEST_F(ResourceIndexCacheTest, storedIndexIsRestored)
+{
+	JsonNode index;
+	index["files"].Vector().emplace_back("first.json");
+	index["files"].Vector().emplace_back("second.json");
+	index["size"].Integer() = 42;
+
+	ResourceIndexCache::save(uniqueKey("index"), index);
+	JsonNode restored = ResourceIndexCache::load(uniqueKey("index"));
+
+	ASSERT_EQ(restored["files"].Vector().size(), 2);
+	EXPECT_EQ(restored["files"].Vector()[0].String(), "first.json");
+	EXPECT_EQ(restored["files"].Vector()[1].String(), "second.json");
+	EXPECT_EQ(restored["size"].Integer(), 42);
+	EXPECT_EQ(restored["key"].String(), uniqueKey("index"));
+}
+
+TEST_F(ResourceIndexCacheTest, missingIndex)
+{
+	EXPECT_TRUE(ResourceIndexCache::load(uniqueKey("missing")).isNull());
+}
+
+TEST_F(ResourceIndexCacheTest, storedIndexIsReplaced)
+{
+	JsonNode first;
+	first["size"].Integer() = 1;
+	JsonNode second;
+	second["size"].Integer() = 2;
+
+	ResourceIndexCache::save(uniqueKey("index"), first);
+	ResourceIndexCache::save(uniqueKey("index"), second);
+
+	EXPECT_EQ(ResourceIndexCache::load(uniqueKey("index"))["size"].Integer(), 2);
+}
+
+TEST_F(ResourceIndexCacheTest, nonUnicodeIndexIsNotStored)
+{
+	JsonNode valid;
+	valid["files"].Vector().emplace_back("valid.json");
+	JsonNode invalid;
+	invalid["files"].Vector().emplace_back("\xff\xfe.json");
+
+	ResourceIndexCache::save(uniqueKey("index"), valid);
+	ResourceIndexCache::save(uniqueKey("index"), invalid);
+
+	JsonNode restored = ResourceIndexCache::load(uniqueKey("index"));
+	ASSERT_EQ(restored["files"].Vector().size(), 1);
+	EXPECT_EQ(restored["files"].Vector()[0].String(), "valid.json");
+}
+
+TEST_F(ResourceIndexCacheTest, noTemporaryFilesAreLeft)
+{
+	JsonNode index;
+	index["size"].Integer() = 1;
+	ResourceIndexCache::save(uniqueKey("index"), index);
+
+	for(const auto & entry : fs::directory_iterator(VCMIDirs::get().userCachePath() / "resourceIndex"))
+		EXPECT_NE(entry.path().extension(), ".tmp") << entry.path();
+}
+
+TEST_F(ResourceIndexCacheTest, modificationTime)
+{
+	createFile("file.json");
+	setModificationTime("file.json", 100);
+
+	EXPECT_EQ(ResourceIndexCache::getModificationTime(directory / "file.json"), std::time(nullptr) - 100);
+	EXPECT_EQ(ResourceIndexCache::getModificationTime(directory / "missing.json"), 0);
+}
+
+TEST_F(ResourceIndexCacheTest, unchangedDirectoryIsRestored)
+{
+	createFile("first.json");
+	setModificationTime("", 100);
+
+	CFilesystemLoader initialLoader("TEST/", directory);
+	EXPECT_TRUE(exists(initialLoader, "TEST/FIRST"));
+
+	// file added without changing modification time of directory can only be found by scanning directory
+	createFile("second.json");
+	setModificationTime("", 100);
+
+	CFilesystemLoader restoredLoader("TEST/", directory);
+	EXPECT_TRUE(exists(restoredLoader, "TEST/FIRST"));
+	EXPECT_FALSE(exists(restoredLoader, "TEST/SECOND"));
+}
+
+TEST_F(ResourceIndexCacheTest, modifiedDirectoryIsScanned)
+{
+	createFile("first.json");
+	setModificationTime("", 100);
+
+	CFilesystemLoader initialLoader("TEST/", directory);
+
+	createFile("second.json");
+	setModificationTime("", 50);
+
+	CFilesystemLoader updatedLoader("TEST/", directory);
+	EXPECT_TRUE(exists(updatedLoader, "TEST/FIRST"));
+	EXPECT_TRUE(exists(updatedLoader, "TEST/SECOND"));
+}
+
+TEST_F(ResourceIndexCacheTest, modifiedSubdirectoryIsScanned)
+{
+	createFile("data/first.json");
+	setModificationTime("data", 100);
+	setModificationTime("", 100);
+
+	CFilesystemLoader initialLoader("TEST/", directory);
+	EXPECT_TRUE(exists(initialLoader, "TEST/DATA/FIRST"));
+
+	createFile("data/second.json");
+	setModificationTime("data", 50);
+
+	CFilesystemLoader updatedLoader("TEST/", directory);
+	EXPECT_TRUE(exists(updatedLoader, "TEST/DATA/FIRST"));
+	EXPECT_TRUE(exists(updatedLoader, "TEST/DATA/SECOND"));
+}
+
+TEST_F(ResourceIndexCacheTest, recentlyModifiedDirectoryIsNotStored)
+{
+	createFile("first.json");
+	std::time_t modified = fs::last_write_time(directory);
+
+	CFilesystemLoader initialLoader("TEST/", directory);
+
+	// directory was modified right before scan, so files added in same second must not be missed
+	createFile("second.json");
+	fs::last_write_time(directory, modified);
+
+	CFilesystemLoader updatedLoader("TEST/", directory);
+	EXPECT_TRUE(exists(updatedLoader, "TEST/SECOND"));
+}
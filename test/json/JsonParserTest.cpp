@@ -0,0 +1,214 @@
+/*
+ * JsonParserTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/json/JsonFormatException.h"
+#include "../../lib/json/JsonNode.h"
+
+// Parser scans input in blocks of 8 characters, so most tests place interesting characters at every position within such block
+
+static JsonNode parseJson(const std::string & text, bool strict, JsonParsingSettings::JsonFormatMode mode = JsonParsingSettings::JsonFormatMode::JSON5)
+{
+	JsonParsingSettings settings;
+	settings.mode = mode;
+	settings.strict = strict;
+
+	// copy into buffer of exact size, so any read past end of input can be detected by sanitizers
+	std::vector<std::byte> buffer(text.size());
+	std::transform(text.begin(), text.end(), buffer.begin(), [](char character)
+	{
+		return static_cast<std::byte>(character);
+	});
+
+	return JsonNode(buffer.data(), buffer.size(), settings, "test");
+}
+
+static std::string createText(size_t length)
+{
+	std::string result;
+	for(size_t i = 0; i < length; ++i)
+		result += static_cast<char>('a' + i % 26);
+	return result;
+}
+
+TEST(JsonParserTest, stringsOfAnyLengthAndAlignment)
+{
+	for(size_t indentation = 0; indentation < 9; ++indentation)
+	{
+		for(size_t length = 0; length < 25; ++length)
+		{
+			std::string expected = createText(length);
+			std::string text = std::string(indentation, ' ') + "\"" + expected + "\"";
+
+			JsonNode node = parseJson(text, true);
+			EXPECT_EQ(node.String(), expected) << "indentation " << indentation << ", length " << length;
+		}
+	}
+}
+
+TEST(JsonParserTest, stringsWithQuotesOfOtherType)
+{
+	for(size_t position = 0; position < 17; ++position)
+	{
+		std::string expected = createText(17);
+
+		std::string withApostrophe = expected;
+		withApostrophe[position] = '\'';
+		EXPECT_EQ(parseJson("\"" + withApostrophe + "\"", true).String(), withApostrophe);
+
+		std::string withQuote = expected;
+		withQuote[position] = '\"';
+		EXPECT_EQ(parseJson("'" + withQuote + "'", true).String(), withQuote);
+	}
+}
+
+TEST(JsonParserTest, escapesAtWordEdges)
+{
+	const std::vector<std::pair<std::string, std::string>> escapes = {
+		{ "\\n", "\n" },
+		{ "\\t", "\t" },
+		{ "\\\"", "\"" },
+		{ "\\\\", "\\" },
+		{ "\\/", "/" }
+	};
+
+	for(const auto & [escaped, unescaped] : escapes)
+	{
+		for(size_t position = 0; position < 17; ++position)
+		{
+			std::string text = createText(17);
+			std::string expected = text;
+
+			text.insert(position, escaped);
+			expected.insert(position, unescaped);
+
+			JsonNode node = parseJson("\"" + text + "\"", true);
+			EXPECT_EQ(node.String(), expected) << "escape " << escaped << " at " << position;
+		}
+	}
+}
+
+TEST(JsonParserTest, consecutiveEscapes)
+{
+	for(size_t count = 1; count < 17; ++count)
+	{
+		std::string text;
+		for(size_t i = 0; i < count; ++i)
+			text += "\\\\";
+
+		EXPECT_EQ(parseJson("\"" + text + "\"", true).String(), std::string(count, '\\'));
+	}
+}
+
+TEST(JsonParserTest, controlCharactersAtWordEdges)
+{
+	for(char control : { '\t', '\r', '\x01', '\x1f' })
+	{
+		for(size_t position = 0; position < 17; ++position)
+		{
+			std::string expected = createText(17);
+			std::string text = expected;
+			text.insert(position, 1, control);
+
+			// control characters are reported and skipped
+			EXPECT_THROW(parseJson("\"" + text + "\"", true), JsonFormatException);
+			EXPECT_EQ(parseJson("\"" + text + "\"", false).String(), expected) << "control character at " << position;
+		}
+	}
+}
+
+TEST(JsonParserTest, lineBreakInString)
+{
+	for(size_t position = 0; position < 17; ++position)
+	{
+		std::string text = createText(17);
+		text.insert(position, 1, '\n');
+
+		EXPECT_THROW(parseJson("\"" + text + "\"", true), JsonFormatException);
+		EXPECT_EQ(parseJson("\"" + text + "\"", false).String(), text.substr(0, position));
+	}
+}
+
+TEST(JsonParserTest, nonAsciiStringsAtWordEdges)
+{
+	const std::string letter = "\xc3\xa9"; // 'e' with acute accent
+
+	for(size_t position = 0; position < 17; ++position)
+	{
+		std::string text = createText(17);
+		text.insert(position, letter);
+
+		EXPECT_EQ(parseJson("\"" + text + "\"", true).String(), text);
+	}
+}
+
+TEST(JsonParserTest, whitespaceRuns)
+{
+	for(const std::string & pattern : { " ", "\t", "\r\n", " \n", "\n\n\t" })
+	{
+		for(size_t count = 0; count < 20; ++count)
+		{
+			std::string whitespace;
+			for(size_t i = 0; i < count; ++i)
+				whitespace += pattern;
+
+			std::string text = whitespace + "{" + whitespace + "\"key\"" + whitespace + ":" + whitespace + "[" + whitespace + "1" + whitespace + "]" + whitespace + "}" + whitespace;
+
+			JsonNode node = parseJson(text, true);
+			ASSERT_EQ(node["key"].Vector().size(), 1);
+			EXPECT_EQ(node["key"].Vector()[0].Integer(), 1);
+		}
+	}
+}
+
+TEST(JsonParserTest, commentsOfAnyLength)
+{
+	for(size_t length = 0; length < 25; ++length)
+	{
+		std::string comment = "//" + createText(length);
+
+		std::string text = comment + "\n{" + comment + "\n\"key\" : 1 " + comment + "\n}" + comment;
+
+		JsonNode node = parseJson(text, true, JsonParsingSettings::JsonFormatMode::JSONC);
+		EXPECT_EQ(node["key"].Integer(), 1) << "comment of length " << length;
+	}
+}
+
+TEST(JsonParserTest, commentsInStrictJson)
+{
+	EXPECT_THROW(parseJson("{ // comment\n \"key\" : 1 }", true, JsonParsingSettings::JsonFormatMode::JSON), JsonFormatException);
+}
+
+TEST(JsonParserTest, truncatedInput)
+{
+	const std::string document = R"({ "key" : "value that is longer than single block", "escaped" : "\"quoted\"", "array" : [ 1, 2.5, true, null ] })";
+
+	ASSERT_NO_THROW(parseJson(document, true));
+
+	for(size_t length = 0; length < document.size(); ++length)
+	{
+		std::string truncated = document.substr(0, length);
+
+		EXPECT_THROW(parseJson(truncated, true), JsonFormatException) << "truncated to " << length;
+		EXPECT_NO_THROW(parseJson(truncated, false)) << "truncated to " << length;
+	}
+}
+
+TEST(JsonParserTest, truncatedString)
+{
+	for(size_t length = 0; length < 17; ++length)
+	{
+		std::string text = "\"" + createText(length);
+
+		EXPECT_THROW(parseJson(text, true), JsonFormatException);
+		EXPECT_THROW(parseJson(text + "\\", true), JsonFormatException);
+	}
+}